@@ -0,0 +1,144 @@
+/**
+ * Copyright (C) 2021, A. Ridyard.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License v2.0 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @file benchmark_receiver.c
+ *
+ * @brief receiver for benchmark_transmitter. Stream packets are
+ * received on DATA_PIPE_0, message fragments on DATA_PIPE_1 and
+ * bulk transfer fragments and polls on DATA_PIPE_2. Packets are
+ * read in batches from the RX FIFO and counted, messages and bulk
+ * transfers are reassembled and printed once completed.
+ */
+
+#include <stdio.h>
+
+#include "nrf24_driver.h"
+#include "message_manager.h"
+#include "pico/stdlib.h"
+
+#include <tusb.h> // TinyUSB tud_cdc_connected()
+
+// RF_DR_250KBPS, RF_DR_1MBPS, RF_DR_2MBPS (same as benchmark_transmitter)
+#ifndef BENCHMARK_DATA_RATE
+#define BENCHMARK_DATA_RATE RF_DR_2MBPS
+#endif
+
+// packets counted on DATA_PIPE_0, before the count is printed
+#define PACKET_REPORT 1000
+
+int main(void)
+{
+  // initialize all present standard stdio types
+  stdio_init_all();
+
+  // wait until the CDC ACM (serial port emulation) is connected
+  while (!tud_cdc_connected())
+  {
+    sleep_ms(10);
+  }
+
+  // GPIO pin numbers
+  pin_manager_t my_pins = {
+    .sck = 2,
+    .copi = 3,
+    .cipo = 4,
+    .csn = 5,
+    .ce = 6
+  };
+
+  nrf_manager_t my_config = {
+    .channel = 120,
+    .address_width = AW_5_BYTES,
+    .dyn_payloads = DYNPD_ENABLE,
+    .data_rate = BENCHMARK_DATA_RATE,
+    .power = RF_PWR_NEG_12DBM,
+    .retr_count = ARC_10RT,
+    .retr_delay = ARD_500US
+  };
+
+  // SPI baudrate, the highest the driver accepts
+  uint32_t my_baudrate = 7500000;
+
+  nrf_client_t my_nrf;
+
+  nrf_driver_create_client(&my_nrf);
+
+  my_nrf.configure(&my_pins, my_baudrate);
+
+  my_nrf.initialise(&my_config);
+
+  // bitmap ACKs of the bulk transfer are returned as ACK payloads
+  my_nrf.ack_payloads_enable();
+
+  my_nrf.rx_destination(DATA_PIPE_0, (uint8_t[]){0x37,0x37,0x37,0x37,0x37});
+  my_nrf.rx_destination(DATA_PIPE_1, (uint8_t[]){0xC7,0xC7,0xC7,0xC7,0xC7});
+  my_nrf.rx_destination(DATA_PIPE_2, (uint8_t[]){0xC8,0xC7,0xC7,0xC7,0xC7});
+
+  // reassembly of messages sent to DATA_PIPE_1
+  static uint8_t message_buffer[MESSAGE_SLOTS * 4096];
+
+  message_manager_t manager;
+  message_manager_init(&manager, &my_nrf, message_buffer, sizeof(message_buffer), 50000);
+
+  // bulk transfers sent to DATA_PIPE_2
+  static uint8_t bulk_buffer[16384];
+
+  bulk_manager_t bulk;
+  message_manager_bulk_init(&bulk, &my_nrf, bulk_buffer, sizeof(bulk_buffer), 64, 16);
+
+  my_nrf.receiver_mode();
+
+  rx_packet_t packets[3];
+  message_t message;
+
+  uint32_t packet_count = 0;
+
+  while (1)
+  {
+    size_t count = 0;
+
+    my_nrf.receive_batch(packets, 3, &count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+      switch (packets[i].data_pipe)
+      {
+        case DATA_PIPE_0:
+          if (++packet_count == PACKET_REPORT)
+          {
+            printf("\nPackets:- %d received\n", PACKET_REPORT);
+
+            packet_count = 0;
+          }
+        break;
+
+        case DATA_PIPE_1:
+          if (message_manager_receive(&manager, &packets[i], &message))
+          {
+            printf("\nMessage:- %d bytes (ID %d) | %lu discarded\n", message.size, message.message_id, manager.discarded);
+          }
+        break;
+
+        case DATA_PIPE_2:
+          if (message_manager_bulk_receive(&bulk, &packets[i], &message))
+          {
+            printf("\nBulk:- %d bytes received\n", message.size);
+          }
+        break;
+
+        default:
+        break;
+      }
+    }
+  }
+
+}
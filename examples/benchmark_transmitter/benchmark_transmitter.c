@@ -0,0 +1,426 @@
+/**
+ * Copyright (C) 2021, A. Ridyard.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License v2.0 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @file benchmark_transmitter.c
+ *
+ * @brief benchmarks for the NRF24L01 driver, run against 
+ * benchmark_receiver. The SPI benchmarks need only the transmitter,
+ * the radio benchmarks need the receiver. Results are printed over
+ * USB serial. Both programs are built with the same 
+ * BENCHMARK_DATA_RATE, so the radio benchmarks are repeated at 
+ * each data rate by rebuilding both.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "nrf24_driver.h"
+#include "message_manager.h"
+#include "spi_manager.h"
+#include "pico/stdlib.h"
+
+#include <tusb.h> // TinyUSB tud_cdc_connected()
+
+// RF_DR_250KBPS, RF_DR_1MBPS, RF_DR_2MBPS (same as benchmark_receiver)
+#ifndef BENCHMARK_DATA_RATE
+#define BENCHMARK_DATA_RATE RF_DR_2MBPS
+#endif
+
+// iterations of each SPI benchmark
+#define SPI_ITERATIONS 1000
+
+// register writes and read backs in the register stress test
+#define STRESS_ITERATIONS 10000
+
+// payloads sent in the stream benchmark and payloads in each send_stream call
+#define STREAM_PACKETS 3000
+#define STREAM_BATCH 30
+
+// RX Mode turnarounds timed
+#define TURNAROUND_ITERATIONS 100
+
+// bytes in each message and messages sent in the message benchmark
+#define MESSAGE_BYTES 4096
+#define MESSAGE_COUNT 8
+
+// bytes in the bulk transfer
+#define BULK_BYTES 16384
+
+// CSN pin number
+#define CSN_PIN 5
+
+// R_REGISTER RX_ADDR_P0, clocking 33 bytes as a payload frame would
+#define FRAME_BYTES 33
+
+// set by the asynchronous DMA transfer completion callback
+static volatile bool is_dma_done = false;
+
+static void dma_callback(fn_status_t status, void *user_data) {
+
+  is_dma_done = true;
+}
+
+
+/**
+ * Times send_packet through the SPI session, against send_packet
+ * preceded by the SPI interface deinit and init, which each driver
+ * call made before the SPI session, giving the per packet overhead
+ * removed.
+ */
+static void benchmark_session(nrf_client_t *my_nrf, uint32_t baudrate) {
+
+  uint8_t payload[MAX_BYTES];
+
+  memset(payload, 0xAA, sizeof(payload));
+
+  my_nrf->tx_destination((uint8_t[]){0x37,0x37,0x37,0x37,0x37});
+
+  uint32_t sent = 0;
+
+  uint32_t start_us = time_us_32();
+
+  for (size_t i = 0; i < SPI_ITERATIONS; i++) { if (my_nrf->send_packet(payload, sizeof(payload))) { sent++; } }
+
+  uint32_t session_us = time_us_32() - start_us;
+
+  start_us = time_us_32();
+
+  for (size_t i = 0; i < SPI_ITERATIONS; i++)
+  {
+    spi_manager_deinit_spi(spi0);
+    spi_manager_init_spi(spi0, baudrate);
+
+    if (my_nrf->send_packet(payload, sizeof(payload))) { sent++; }
+  }
+
+  uint32_t init_us = time_us_32() - start_us;
+
+  printf("\nSession:- %lu/%d acknowledged | send_packet %luμS | with spi init/deinit %luμS | %lu ns/packet removed\n",
+    sent, SPI_ITERATIONS * 2, session_us / SPI_ITERATIONS, init_us / SPI_ITERATIONS,
+    (init_us > session_us) ? ((init_us - session_us) * 1000) / SPI_ITERATIONS : 0);
+}
+
+
+/**
+ * Writes RF_CH and reads it back, STRESS_ITERATIONS times, at the
+ * 7.5MHz SPI baudrate with no CSN setup/hold time, counting read
+ * backs which do not match, then times the same frames with the 
+ * 2μS padding used before.
+ */
+static void benchmark_registers(nrf_client_t *my_nrf, uint8_t channel) {
+
+  // W_REGISTER (0x20) | RF_CH (0x05), channel
+  uint8_t tx_write[2] = { 0x25, channel };
+
+  // R_REGISTER (0x00) | RF_CH (0x05), NOP
+  uint8_t tx_read[2] = { 0x05, 0xFF };
+
+  uint8_t rx_frame[2];
+
+  uint32_t mismatches = 0;
+
+  my_nrf->csn_timing(0, 0);
+
+  uint32_t start_us = time_us_32();
+
+  for (size_t i = 0; i < STRESS_ITERATIONS; i++)
+  {
+    tx_write[1] = i % 126;
+
+    gpio_put(CSN_PIN, 0);
+    spi_manager_transfer(spi0, tx_write, rx_frame, sizeof(tx_write));
+    gpio_put(CSN_PIN, 1);
+
+    gpio_put(CSN_PIN, 0);
+    spi_manager_transfer(spi0, tx_read, rx_frame, sizeof(tx_read));
+    gpio_put(CSN_PIN, 1);
+
+    if (rx_frame[1] != tx_write[1]) { mismatches++; }
+  }
+
+  uint32_t unpadded_us = time_us_32() - start_us;
+
+  my_nrf->csn_timing(2000, 2000);
+
+  start_us = time_us_32();
+
+  for (size_t i = 0; i < STRESS_ITERATIONS; i++)
+  {
+    gpio_put(CSN_PIN, 0);
+    spi_manager_transfer(spi0, tx_write, rx_frame, sizeof(tx_write));
+    gpio_put(CSN_PIN, 1);
+
+    gpio_put(CSN_PIN, 0);
+    spi_manager_transfer(spi0, tx_read, rx_frame, sizeof(tx_read));
+    gpio_put(CSN_PIN, 1);
+  }
+
+  uint32_t padded_us = time_us_32() - start_us;
+
+  my_nrf->csn_timing(0, 0);
+
+  // RF_CH is written back, as set by the driver
+  tx_write[1] = channel;
+
+  gpio_put(CSN_PIN, 0);
+  spi_manager_transfer(spi0, tx_write, rx_frame, sizeof(tx_write));
+  gpio_put(CSN_PIN, 1);
+
+  printf("\nRegisters:- %lu mismatches in %d read backs | write & read back %lu ns (2μS padding %lu ns)\n",
+    mismatches, STRESS_ITERATIONS, (unpadded_us * 1000) / STRESS_ITERATIONS, (padded_us * 1000) / STRESS_ITERATIONS);
+}
+
+
+/**
+ * Times a 33 byte frame clocked by the CPU, by blocking DMA and
+ * by asynchronous DMA, with the CPU time the asynchronous call
+ * returns after.
+ */
+static void benchmark_dma(void) {
+
+  uint8_t tx_frame[FRAME_BYTES];
+  uint8_t rx_frame[FRAME_BYTES];
+
+  memset(tx_frame, 0xFF, sizeof(tx_frame));
+
+  // R_REGISTER (0x00) | RX_ADDR_P0 (0x0A)
+  tx_frame[0] = 0x0A;
+
+  uint32_t start_us = time_us_32();
+
+  for (size_t i = 0; i < SPI_ITERATIONS; i++)
+  {
+    gpio_put(CSN_PIN, 0);
+    spi_manager_transfer(spi0, tx_frame, rx_frame, FRAME_BYTES);
+    gpio_put(CSN_PIN, 1);
+  }
+
+  uint32_t cpu_us = time_us_32() - start_us;
+
+  start_us = time_us_32();
+
+  for (size_t i = 0; i < SPI_ITERATIONS; i++) { spi_manager_transfer_dma(spi0, CSN_PIN, tx_frame, rx_frame, FRAME_BYTES); }
+
+  uint32_t dma_us = time_us_32() - start_us;
+
+  uint32_t async_us = 0;
+  uint32_t call_us = 0;
+
+  for (size_t i = 0; i < SPI_ITERATIONS; i++)
+  {
+    is_dma_done = false;
+
+    start_us = time_us_32();
+
+    spi_manager_transfer_dma_async(spi0, CSN_PIN, tx_frame, rx_frame, FRAME_BYTES, dma_callback, NULL);
+
+    // CPU is free from here, until the callback
+    call_us += time_us_32() - start_us;
+
+    while (!is_dma_done) { tight_loop_contents(); }
+
+    async_us += time_us_32() - start_us;
+  }
+
+  printf("\nDMA:- %d byte frame, CPU %lu ns | DMA %lu ns | async %lu ns (CPU busy %lu ns)\n", FRAME_BYTES,
+    (cpu_us * 1000) / SPI_ITERATIONS, (dma_us * 1000) / SPI_ITERATIONS,
+    (async_us * 1000) / SPI_ITERATIONS, (call_us * 1000) / SPI_ITERATIONS);
+}
+
+
+/**
+ * Streams 32 byte payloads to the receiver through send_stream,
+ * keeping the TX FIFO full in Standby-II.
+ */
+static void benchmark_stream(nrf_client_t *my_nrf) {
+
+  static uint8_t batch[STREAM_BATCH][MAX_BYTES];
+
+  for (size_t i = 0; i < STREAM_BATCH; i++) { memset(batch[i], (int)i, MAX_BYTES); }
+
+  my_nrf->tx_destination((uint8_t[]){0x37,0x37,0x37,0x37,0x37});
+
+  uint32_t sent = 0;
+
+  uint32_t start_us = time_us_32();
+
+  for (size_t i = 0; i < (STREAM_PACKETS / STREAM_BATCH); i++)
+  {
+    fn_status_irq_t outcomes[STREAM_BATCH];
+
+    my_nrf->send_stream(batch, MAX_BYTES, STREAM_BATCH, outcomes);
+
+    for (size_t j = 0; j < STREAM_BATCH; j++) { if (outcomes[j] == TX_DS_ASSERTED) { sent++; } }
+  }
+
+  uint32_t elapsed_us = time_us_32() - start_us;
+
+  printf("\nStream:- %lu/%d acknowledged | %lu packets/s\n", sent, STREAM_PACKETS, (uint32_t)(((uint64_t)sent * 1000000) / elapsed_us));
+}
+
+
+/**
+ * Times Standby-I to RX Mode, until RX_READY_EVENT, and back
+ * to Standby-I.
+ */
+static void benchmark_turnaround(nrf_client_t *my_nrf) {
+
+  uint32_t total_us = 0;
+  uint32_t worst_us = 0;
+
+  for (size_t i = 0; i < TURNAROUND_ITERATIONS; i++)
+  {
+    uint8_t events = 0;
+
+    uint32_t start_us = time_us_32();
+
+    my_nrf->receiver_mode();
+
+    while (!(events & RX_READY_EVENT)) { my_nrf->poll_events(&events, NULL); }
+
+    my_nrf->standby_mode();
+
+    uint32_t elapsed_us = time_us_32() - start_us;
+
+    total_us += elapsed_us;
+
+    if (elapsed_us > worst_us) { worst_us = elapsed_us; }
+  }
+
+  printf("\nTurnaround:- Standby-I > RX ready > Standby-I average %luμS | worst %luμS\n", total_us / TURNAROUND_ITERATIONS, worst_us);
+}
+
+
+/**
+ * Sends messages of MESSAGE_BYTES through message_manager,
+ * reporting application bytes per second.
+ */
+static void benchmark_messages(nrf_client_t *my_nrf) {
+
+  static uint8_t message[MESSAGE_BYTES];
+
+  for (size_t i = 0; i < MESSAGE_BYTES; i++) { message[i] = (uint8_t)i; }
+
+  // transmitter only sends, so no reassembly buffer is needed beyond one fragment per slot
+  static uint8_t buffer[MESSAGE_SLOTS * MESSAGE_FRAGMENT_BYTES];
+
+  message_manager_t manager;
+  message_manager_init(&manager, my_nrf, buffer, sizeof(buffer), 50000);
+
+  my_nrf->tx_destination((uint8_t[]){0xC7,0xC7,0xC7,0xC7,0xC7});
+
+  uint32_t sent = 0;
+
+  uint32_t start_us = time_us_32();
+
+  for (size_t i = 0; i < MESSAGE_COUNT; i++) { if (message_manager_send(&manager, message, sizeof(message))) { sent++; } }
+
+  uint32_t elapsed_us = time_us_32() - start_us;
+
+  printf("\nMessages:- %lu/%d of %d bytes | %lu bytes/s\n", sent, MESSAGE_COUNT, MESSAGE_BYTES,
+    (uint32_t)(((uint64_t)sent * MESSAGE_BYTES * 1000000) / elapsed_us));
+}
+
+
+/**
+ * Sends BULK_BYTES through the selective repeat bulk transfer,
+ * reporting goodput at BENCHMARK_DATA_RATE and retransmissions.
+ */
+static void benchmark_bulk(nrf_client_t *my_nrf) {
+
+  static uint8_t data[BULK_BYTES];
+
+  for (size_t i = 0; i < BULK_BYTES; i++) { data[i] = (uint8_t)(i * 7); }
+
+  bulk_manager_t bulk;
+  message_manager_bulk_init(&bulk, my_nrf, NULL, 0, 64, 16);
+
+  my_nrf->tx_destination((uint8_t[]){0xC8,0xC7,0xC7,0xC7,0xC7});
+
+  const char *data_rate = (BENCHMARK_DATA_RATE == RF_DR_250KBPS) ? "250kbps" : (BENCHMARK_DATA_RATE == RF_DR_1MBPS) ? "1Mbps" : "2Mbps";
+
+  uint32_t retransmitted = 0;
+  uint32_t goodput = 0;
+
+  if (message_manager_bulk_send(&bulk, data, sizeof(data)) && message_manager_bulk_stats(&bulk, &retransmitted, &goodput))
+  {
+    printf("\nBulk:- %d bytes at %s | %lu bytes/s | %lu retransmitted\n", BULK_BYTES, data_rate, goodput, retransmitted);
+
+  } else {
+
+    printf("\nBulk:- transfer failed, receiver not available.\n");
+  }
+}
+
+
+int main(void)
+{
+  // initialize all present standard stdio types
+  stdio_init_all();
+
+  // wait until the CDC ACM (serial port emulation) is connected
+  while (!tud_cdc_connected())
+  {
+    sleep_ms(10);
+  }
+
+  // GPIO pin numbers
+  pin_manager_t my_pins = {
+    .sck = 2,
+    .copi = 3,
+    .cipo = 4,
+    .csn = CSN_PIN,
+    .ce = 6
+  };
+
+  nrf_manager_t my_config = {
+    .channel = 120,
+    .address_width = AW_5_BYTES,
+    .dyn_payloads = DYNPD_ENABLE,
+    .data_rate = BENCHMARK_DATA_RATE,
+    .power = RF_PWR_NEG_12DBM,
+    .retr_count = ARC_10RT,
+
+    // long enough for a bitmap ACK payload at 2Mbps
+    .retr_delay = ARD_500US
+  };
+
+  // SPI baudrate, the highest the driver accepts
+  uint32_t my_baudrate = 7500000;
+
+  nrf_client_t my_nrf;
+
+  nrf_driver_create_client(&my_nrf);
+
+  my_nrf.configure(&my_pins, my_baudrate);
+
+  my_nrf.initialise(&my_config);
+
+  // bitmap ACKs of the bulk transfer are returned as ACK payloads
+  my_nrf.ack_payloads_enable();
+
+  my_nrf.standby_mode();
+
+  while (1) {
+
+    benchmark_session(&my_nrf, my_baudrate);
+    benchmark_registers(&my_nrf, my_config.channel);
+    benchmark_dma();
+    benchmark_turnaround(&my_nrf);
+    benchmark_stream(&my_nrf);
+    benchmark_messages(&my_nrf);
+    benchmark_bulk(&my_nrf);
+
+    sleep_ms(5000);
+  }
+
+}
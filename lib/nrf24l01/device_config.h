@@ -120,7 +120,8 @@ typedef enum bitwise_masks_e
   STATUS_RX_P_NO_MASK = 0x07, // 0b00000111
   REGISTER_MASK = 0x1F, // 0b00011111
   RF_SETUP_RF_DR_MASK = 0x28, // 0b00101000
-  STATUS_INTERRUPT_MASK = 0x70 // 0b01110000
+  STATUS_INTERRUPT_MASK = 0x70, // 0b01110000
+  OBSERVE_TX_CNT_MASK = 0x0F // 0b00001111
 } bitwise_masks_t;  
 
 
@@ -265,6 +266,22 @@ typedef enum status_bit_e
 } status_bit_t;
 
 
+/**
+ * OBSERVE_TX register (0x08):
+ * 
+ * Transmit observe register
+ * 
+ * Mnemonic    | Bit | Comment
+ * PLOS_CNT     4:7   Count lost packets, reset by writing RF_CH
+ * ARC_CNT      0:3   Count retransmitted packets, reset by a new packet
+ **/
+typedef enum observe_tx_bit_e
+{
+  OBSERVE_TX_ARC_CNT, // Bit 0:3
+  OBSERVE_TX_PLOS_CNT = 4 // Bit 4:7
+} observe_tx_bit_t;
+
+
 // FIFO_STATUS register bit mnemonics
 typedef enum fifo_status_bit_e
 {
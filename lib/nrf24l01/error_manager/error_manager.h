@@ -25,7 +25,8 @@ typedef enum fn_status_e
   ERROR,
   PIN_MNGR_OK,
   SPI_MNGR_OK,
-  NRF_MNGR_OK
+  NRF_MNGR_OK,
+  MSG_MNGR_OK
 } fn_status_t;
 
 // return values for STATUS register functions
@@ -37,4 +38,23 @@ typedef enum fn_status_irq_e
   MAX_RT_ASSERTED // MAX_RT bit asserted
 } fn_status_irq_t;
 
+// events for STATUS register functions, as a bitmask (STATUS register bit positions)
+typedef enum fn_status_event_e
+{
+  NO_EVENTS = 0x00, // no IRQ bits asserted
+  TX_FULL_EVENT = 0x01, // TX FIFO full
+  MAX_RT_EVENT = 0x10, // MAX_RT bit asserted
+  TX_DS_EVENT = 0x20, // TX_DS bit asserted
+  RX_DR_EVENT = 0x40, // RX_DR bit asserted
+  RX_READY_EVENT = 0x80 // RX Mode settling time completed (STATUS bit 7 is always 0)
+} fn_status_event_t;
+
+// return values for queue functions
+typedef enum fn_status_queue_e
+{
+  QUEUE_ERROR, // queue disabled or invalid argument
+  QUEUE_FULL, // no free entry, retry once entries have completed
+  QUEUE_OK // entry queued
+} fn_status_queue_t;
+
 #endif // ERROR_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,629 @@
+/**
+ * Copyright (C) 2021, A. Ridyard.
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License v2.0 as
+ * published by the Free Software Foundation.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * @file message_manager.c
+ * 
+ * @brief function definitions for sending messages larger than
+ * one payload, as fragments, and reassembling them.
+ */
+
+#include <string.h>
+#include "message_manager.h"
+#include "pico/time.h"
+
+// fragments staged for each send_stream call
+#define MESSAGE_BATCH 8
+
+// header byte 2, set on the last fragment of a message
+#define MESSAGE_LAST_FLAG 0x80
+
+// header byte 2, message bytes in the fragment
+#define MESSAGE_WIDTH_MASK 0x1F
+
+// header byte offsets in a fragment
+enum { HEADER_MESSAGE_ID, HEADER_INDEX, HEADER_FLAGS };
+
+// bulk transfer header byte 0, packet type (bits 7:5) and message bytes (bits 4:0)
+#define BULK_TYPE_MASK 0xE0
+#define BULK_DATA 0x20
+#define BULK_LAST 0x40
+#define BULK_POLL 0x60
+#define BULK_ACK 0x80
+
+// bitmap ACK bytes (type, poll ID, transfer ID, base sequence and bitmap)
+#define BULK_ACK_BYTES (BULK_HEADER_BYTES + 2 + (BULK_MAX_WINDOW / 8))
+
+// poll attempts for a bitmap ACK and the delay between them (us)
+#define BULK_POLL_RETRIES 20
+#define BULK_POLL_DELAY_US 500
+
+// bulk transfer header byte offsets (sequence or poll ID is little-endian)
+enum { BULK_HEADER_TYPE, BULK_HEADER_SEQ_LSB, BULK_HEADER_SEQ_MSB, BULK_HEADER_TRANSFER };
+
+// bitmap ACK byte offsets, after the bulk transfer header
+enum { BULK_ACK_BASE_LSB = BULK_HEADER_BYTES, BULK_ACK_BASE_MSB, BULK_ACK_BITMAP };
+
+
+/**
+ * Discards any incomplete message not updated within timeout_us.
+ * 
+ * @param manager message_manager_t struct
+ * @param now_us current time (us since boot)
+ */
+static void expire_slots(message_manager_t *manager, uint32_t now_us) {
+
+  for (size_t i = 0; i < MESSAGE_SLOTS; i++)
+  {
+    message_slot_t *slot = &(manager->slots[i]);
+
+    if (slot->is_active && ((now_us - slot->updated_us) > manager->timeout_us))
+    {
+      slot->is_active = false;
+      manager->discarded++;
+    }
+  }
+
+  return;
+}
+
+
+/**
+ * Finds the slot reassembling a message. A free slot, or else 
+ * the oldest slot, is taken for a new message.
+ * 
+ * @param manager message_manager_t struct
+ * @param message_id message ID in the fragment header
+ * @param data_pipe data pipe the fragment was received on
+ * @param now_us current time (us since boot)
+ * 
+ * @return slot for the message
+ */
+static message_slot_t *find_slot(message_manager_t *manager, uint8_t message_id, data_pipe_t data_pipe, uint32_t now_us) {
+
+  message_slot_t *found = NULL;
+  message_slot_t *oldest = &(manager->slots[0]);
+
+  for (size_t i = 0; i < MESSAGE_SLOTS; i++)
+  {
+    message_slot_t *slot = &(manager->slots[i]);
+
+    if (slot->is_active && (slot->message_id == message_id) && (slot->data_pipe == data_pipe)) { found = slot; }
+
+    // an inactive slot is free and is always taken first
+    if (!slot->is_active || (oldest->is_active && ((int32_t)(slot->updated_us - oldest->updated_us) < 0))) { oldest = slot; }
+  }
+
+  if (found == NULL)
+  {
+    found = oldest;
+
+    if (found->is_active) { manager->discarded++; }
+
+    found->is_active = true;
+    found->message_id = message_id;
+    found->data_pipe = data_pipe;
+    found->last_index = -1;
+    found->received = 0;
+    found->size = 0;
+
+    memset(found->bitmap, 0, sizeof(found->bitmap));
+  }
+
+  found->updated_us = now_us;
+
+  return found;
+}
+
+
+/**
+ * Sends a poll with auto-acknowledgement, until a bitmap ACK for 
+ * the poll is returned as an ACK payload. The receiver queues the
+ * bitmap ACK once the poll arrives, so the first auto-acknowledgement
+ * returns no ACK payload, or one for an earlier poll, which is skipped.
+ * Any other packet read from the RX FIFO is discarded and counted.
+ * 
+ * @param bulk bulk_manager_t struct
+ * @param ack buffer for the bitmap ACK (BULK_ACK_BYTES)
+ * 
+ * @return MSG_MNGR_OK (4), ERROR (0) if no bitmap ACK after BULK_POLL_RETRIES
+ */
+static fn_status_t bulk_poll(bulk_manager_t *bulk, uint8_t *ack) {
+
+  nrf_client_t *client = bulk->client;
+
+  uint16_t poll_id = ++(bulk->poll_id);
+
+  uint8_t poll[BULK_HEADER_BYTES] = { BULK_POLL, (uint8_t)poll_id, (uint8_t)(poll_id >> 8), bulk->transfer_id };
+
+  fn_status_t status = ERROR;
+
+  for (size_t attempt = 0; (status == ERROR) && (attempt < BULK_POLL_RETRIES); attempt++)
+  {
+    if (client->send_packet(poll, sizeof(poll)) == NRF_MNGR_OK)
+    {
+      rx_packet_t packet;
+
+      // ACK payloads are read from the RX FIFO, as packets on DATA_PIPE_0
+      while ((status == ERROR) && (client->receive_batch(&packet, 1, NULL) == NRF_MNGR_OK))
+      {
+        const uint8_t *reply = packet.payload;
+
+        bool is_ack = (packet.width == BULK_ACK_BYTES) && (reply[BULK_HEADER_TYPE] == BULK_ACK) && (reply[BULK_HEADER_TRANSFER] == bulk->transfer_id);
+
+        if (is_ack && (reply[BULK_HEADER_SEQ_LSB] == (uint8_t)poll_id) && (reply[BULK_HEADER_SEQ_MSB] == (uint8_t)(poll_id >> 8)))
+        {
+          memcpy(ack, reply, BULK_ACK_BYTES);
+
+          status = MSG_MNGR_OK;
+
+        } else if (!is_ack) {
+
+          // a packet which is not a bitmap ACK can not be left in the RX FIFO
+          bulk->discarded++;
+        }
+      }
+    }
+
+    // time for the receiver to queue the bitmap ACK
+    if (status == ERROR) { sleep_us(BULK_POLL_DELAY_US); }
+  }
+
+  return status;
+}
+
+
+// see message_manager.h
+fn_status_t message_manager_init(message_manager_t *manager, nrf_client_t *client, uint8_t *buffer, size_t size, uint32_t timeout_us) {
+
+  // each slot holds at least one fragment
+  fn_status_t status = ((client != NULL) && (buffer != NULL) && ((size / MESSAGE_SLOTS) >= MESSAGE_FRAGMENT_BYTES)) ? MSG_MNGR_OK : ERROR;
+
+  if (status == MSG_MNGR_OK)
+  {
+    manager->client = client;
+    manager->tx_message_id = 0;
+    manager->capacity = size / MESSAGE_SLOTS;
+    manager->timeout_us = timeout_us;
+    manager->discarded = 0;
+
+    for (size_t i = 0; i < MESSAGE_SLOTS; i++)
+    {
+      manager->slots[i] = (message_slot_t){ .buffer = &buffer[i * manager->capacity], .is_active = false };
+    }
+  }
+
+  return status;
+}
+
+
+// see message_manager.h
+fn_status_t message_manager_send(message_manager_t *manager, const void *message, size_t size) {
+
+  const uint8_t *message_ptr = (const uint8_t *)message;
+
+  fn_status_t status = ((message != NULL) && (size > 0) && (size <= MESSAGE_MAX_BYTES)) ? MSG_MNGR_OK : ERROR;
+
+  // fragments in the message, rounded up
+  size_t fragments = (size + MESSAGE_FRAGMENT_BYTES - 1) / MESSAGE_FRAGMENT_BYTES;
+
+  uint8_t message_id = manager->tx_message_id++;
+
+  // fragments staged back to back, for send_stream
+  uint8_t batch[MESSAGE_BATCH][MAX_BYTES];
+
+  for (size_t index = 0; (status == MSG_MNGR_OK) && (index < fragments); )
+  {
+    size_t count = 0;
+
+    while ((count < MESSAGE_BATCH) && (index < fragments))
+    {
+      size_t offset = index * MESSAGE_FRAGMENT_BYTES;
+      size_t width = ((size - offset) < MESSAGE_FRAGMENT_BYTES) ? (size - offset) : MESSAGE_FRAGMENT_BYTES;
+
+      uint8_t *fragment = batch[count];
+
+      fragment[HEADER_MESSAGE_ID] = message_id;
+      fragment[HEADER_INDEX] = (uint8_t)index;
+      fragment[HEADER_FLAGS] = (uint8_t)width | ((index == (fragments - 1)) ? MESSAGE_LAST_FLAG : 0);
+
+      memcpy(&fragment[MESSAGE_HEADER_BYTES], &message_ptr[offset], width);
+
+      // the last fragment is padded to MAX_BYTES
+      memset(&fragment[MESSAGE_HEADER_BYTES + width], 0, MESSAGE_FRAGMENT_BYTES - width);
+
+      count++;
+      index++;
+    }
+
+    // outcome of each fragment in the batch
+    fn_status_irq_t outcomes[MESSAGE_BATCH];
+
+    for (size_t attempt = 0; (count > 0) && (attempt <= MESSAGE_RETRIES); attempt++)
+    {
+      // a fragment without an outcome (send_stream failed before it was sent) is resent
+      for (size_t i = 0; i < count; i++) { outcomes[i] = NONE_ASSERTED; }
+
+      manager->client->send_stream(batch, MAX_BYTES, count, outcomes);
+
+      size_t failed = 0;
+
+      // fragments not acknowledged are moved to the front of the batch, in order
+      for (size_t i = 0; i < count; i++)
+      {
+        if (outcomes[i] != TX_DS_ASSERTED)
+        {
+          if (failed != i) { memcpy(batch[failed], batch[i], MAX_BYTES); }
+
+          failed++;
+        }
+      }
+
+      count = failed;
+    }
+
+    status = (count == 0) ? MSG_MNGR_OK : ERROR;
+  }
+
+  return status;
+}
+
+
+// see message_manager.h
+fn_status_t message_manager_receive(message_manager_t *manager, const rx_packet_t *packet, message_t *message) {
+
+  const uint8_t *fragment = packet->payload;
+
+  uint32_t now_us = time_us_32();
+
+  // incomplete messages are discarded on every call, whether or not the packet is a fragment
+  expire_slots(manager, now_us);
+
+  fn_status_t status = (packet->width > MESSAGE_HEADER_BYTES) ? MSG_MNGR_OK : ERROR;
+
+  size_t index = 0;
+  size_t width = 0;
+  bool is_last = false;
+
+  if (status == MSG_MNGR_OK)
+  {
+    index = fragment[HEADER_INDEX];
+    width = fragment[HEADER_FLAGS] & MESSAGE_WIDTH_MASK;
+    is_last = (fragment[HEADER_FLAGS] & MESSAGE_LAST_FLAG) != 0;
+
+    // only the last fragment carries fewer than MESSAGE_FRAGMENT_BYTES
+    if ((width > MESSAGE_FRAGMENT_BYTES) || (width > (size_t)(packet->width - MESSAGE_HEADER_BYTES)) || (!is_last && (width != MESSAGE_FRAGMENT_BYTES)))
+    {
+      status = ERROR;
+    }
+  }
+
+  if (status == MSG_MNGR_OK)
+  {
+    message_slot_t *slot = find_slot(manager, fragment[HEADER_MESSAGE_ID], packet->data_pipe, now_us);
+
+    size_t offset = index * MESSAGE_FRAGMENT_BYTES;
+
+    uint8_t mask = 1 << (index & 7);
+
+    if ((offset + width) > manager->capacity)
+    {
+      // the message does not fit in a slot buffer
+      slot->is_active = false;
+      manager->discarded++;
+
+      status = ERROR;
+
+    } else if (!(slot->bitmap[index >> 3] & mask)) {
+
+      // a fragment received twice is only counted once
+      slot->bitmap[index >> 3] |= mask;
+      slot->received++;
+      slot->size += width;
+
+      if (is_last) { slot->last_index = (int16_t)index; }
+
+      memcpy(&(slot->buffer[offset]), &fragment[MESSAGE_HEADER_BYTES], width);
+    }
+
+    // every fragment up to the last has been received
+    if ((status == MSG_MNGR_OK) && slot->is_active && (slot->last_index >= 0) && (slot->received == (slot->last_index + 1)))
+    {
+      slot->is_active = false;
+
+      if (message != NULL)
+      {
+        *message = (message_t){ .payload = slot->buffer, .size = slot->size, .message_id = slot->message_id, .data_pipe = slot->data_pipe };
+      }
+
+    } else {
+
+      status = ERROR;
+    }
+  }
+
+  return status;
+}
+
+
+// see message_manager.h
+fn_status_t message_manager_bulk_init(bulk_manager_t *bulk, nrf_client_t *client, uint8_t *buffer, size_t size, uint16_t window, uint16_t ack_interval) {
+
+  fn_status_t status = ((client != NULL) && (window > 0) && (window <= BULK_MAX_WINDOW) && (ack_interval > 0) && (ack_interval <= window)) ? MSG_MNGR_OK : ERROR;
+
+  if (status == MSG_MNGR_OK)
+  {
+    *bulk = (bulk_manager_t){
+      .client = client,
+      .window = window,
+      .ack_interval = ack_interval,
+      .poll_id = 0,
+      .ack_poll_id = 0,
+      // a sender starts from an arbitrary ID, so a restarted sender is unlikely to repeat the last ID received
+      .transfer_id = (buffer == NULL) ? (uint8_t)time_us_32() : 0,
+      .buffer = buffer,
+      .capacity = (buffer != NULL) ? size : 0,
+      .base = 0,
+      .last_seq = -1,
+      .size = 0,
+      .is_complete = false,
+      .transmitted = 0,
+      .retransmitted = 0,
+      .discarded = 0,
+      .bytes = 0,
+      .elapsed_us = 0
+    };
+  }
+
+  return status;
+}
+
+
+// see message_manager.h
+fn_status_t message_manager_bulk_send(bulk_manager_t *bulk, const void *data, size_t size) {
+
+  const uint8_t *data_ptr = (const uint8_t *)data;
+
+  fn_status_t status = ((data != NULL) && (size > 0) && (size <= BULK_MAX_BYTES)) ? MSG_MNGR_OK : ERROR;
+
+  // fragments in the transfer, rounded up
+  uint32_t fragments = (size + BULK_FRAGMENT_BYTES - 1) / BULK_FRAGMENT_BYTES;
+
+  // lowest sequence not yet acknowledged
+  uint32_t base = 0;
+
+  // acknowledged fragments above base, one bit for each sequence (modulo BULK_MAX_WINDOW)
+  uint8_t acked[BULK_MAX_WINDOW / 8];
+  memset(acked, 0, sizeof(acked));
+
+  // fragments staged back to back, for send_stream_noack
+  uint8_t batch[MESSAGE_BATCH][MAX_BYTES];
+
+  uint8_t ack[BULK_ACK_BYTES];
+
+  uint32_t start_us = time_us_32();
+
+  bulk->transmitted = 0;
+  bulk->discarded = 0;
+
+  // a new transfer ID starts the receiver again
+  bulk->transfer_id++;
+
+  while ((status == MSG_MNGR_OK) && (base < fragments))
+  {
+    uint32_t end = ((base + bulk->window) < fragments) ? (base + bulk->window) : fragments;
+
+    size_t sent = 0;
+    size_t count = 0;
+
+    // unacknowledged fragments in the window, missing or not yet sent, up to ack_interval
+    for (uint32_t seq = base; (status == MSG_MNGR_OK) && (seq < end) && (sent < bulk->ack_interval); seq++)
+    {
+      uint32_t bit = seq % BULK_MAX_WINDOW;
+
+      if (!(acked[bit >> 3] & (1 << (bit & 7))))
+      {
+        size_t offset = seq * BULK_FRAGMENT_BYTES;
+        size_t width = ((size - offset) < BULK_FRAGMENT_BYTES) ? (size - offset) : BULK_FRAGMENT_BYTES;
+
+        uint8_t *fragment = batch[count];
+
+        fragment[BULK_HEADER_TYPE] = ((seq == (fragments - 1)) ? BULK_LAST : BULK_DATA) | (uint8_t)width;
+        fragment[BULK_HEADER_SEQ_LSB] = (uint8_t)seq;
+        fragment[BULK_HEADER_SEQ_MSB] = (uint8_t)(seq >> 8);
+        fragment[BULK_HEADER_TRANSFER] = bulk->transfer_id;
+
+        memcpy(&fragment[BULK_HEADER_BYTES], &data_ptr[offset], width);
+
+        // the last fragment is padded to MAX_BYTES
+        memset(&fragment[BULK_HEADER_BYTES + width], 0, BULK_FRAGMENT_BYTES - width);
+
+        count++;
+        sent++;
+      }
+
+      if ((count == MESSAGE_BATCH) || ((count > 0) && (((seq + 1) == end) || (sent == bulk->ack_interval))))
+      {
+        status = (bulk->client->send_stream_noack(batch, MAX_BYTES, count) == NRF_MNGR_OK) ? MSG_MNGR_OK : ERROR;
+
+        count = 0;
+      }
+    }
+
+    bulk->transmitted += sent;
+
+    // every fragment sent has arrived, or been lost, before the poll
+    if (status == MSG_MNGR_OK) { status = bulk_poll(bulk, ack); }
+
+    if (status == MSG_MNGR_OK)
+    {
+      uint32_t ack_base = ack[BULK_ACK_BASE_LSB] | (ack[BULK_ACK_BASE_MSB] << 8);
+
+      // fragments below the receiver base are acknowledged and leave the window
+      while ((base < ack_base) && (base < fragments))
+      {
+        uint32_t bit = base % BULK_MAX_WINDOW;
+
+        acked[bit >> 3] &= ~(1 << (bit & 7));
+
+        base++;
+      }
+
+      // bitmap bit i acknowledges sequence ack_base + i
+      for (uint32_t i = 0; (ack_base == base) && (i < bulk->window) && ((base + i) < fragments); i++)
+      {
+        if (ack[BULK_ACK_BITMAP + (i >> 3)] & (1 << (i & 7)))
+        {
+          uint32_t bit = (base + i) % BULK_MAX_WINDOW;
+
+          acked[bit >> 3] |= (1 << (bit & 7));
+        }
+      }
+    }
+  }
+
+  if (status == MSG_MNGR_OK)
+  {
+    bulk->retransmitted = bulk->transmitted - fragments;
+    bulk->bytes = size;
+    bulk->elapsed_us = time_us_32() - start_us;
+  }
+
+  return status;
+}
+
+
+// see message_manager.h
+fn_status_t message_manager_bulk_receive(bulk_manager_t *bulk, const rx_packet_t *packet, message_t *message) {
+
+  const uint8_t *fragment = packet->payload;
+
+  fn_status_t status = ((bulk->buffer != NULL) && (packet->width >= BULK_HEADER_BYTES)) ? MSG_MNGR_OK : ERROR;
+
+  uint8_t type = fragment[BULK_HEADER_TYPE] & BULK_TYPE_MASK;
+  size_t width = fragment[BULK_HEADER_TYPE] & MESSAGE_WIDTH_MASK;
+
+  // sequence of a fragment or ID of a poll
+  uint32_t seq = fragment[BULK_HEADER_SEQ_LSB] | (fragment[BULK_HEADER_SEQ_MSB] << 8);
+
+  bool is_bulk = (type == BULK_DATA) || (type == BULK_LAST) || (type == BULK_POLL);
+
+  // a new transfer ID starts the next transfer, discarding an aborted one
+  if ((status == MSG_MNGR_OK) && is_bulk && (fragment[BULK_HEADER_TRANSFER] != bulk->transfer_id))
+  {
+    bulk->transfer_id = fragment[BULK_HEADER_TRANSFER];
+    bulk->base = 0;
+    bulk->last_seq = -1;
+    bulk->size = 0;
+    bulk->is_complete = false;
+
+    memset(bulk->bitmap, 0, sizeof(bulk->bitmap));
+  }
+
+  if ((status == MSG_MNGR_OK) && ((type == BULK_DATA) || (type == BULK_LAST)))
+  {
+    size_t offset = seq * BULK_FRAGMENT_BYTES;
+
+    uint32_t bit = seq % BULK_MAX_WINDOW;
+
+    // only the last fragment carries fewer than BULK_FRAGMENT_BYTES
+    bool is_valid = (width <= BULK_FRAGMENT_BYTES) && (width <= (size_t)(packet->width - BULK_HEADER_BYTES)) && ((type == BULK_LAST) || (width == BULK_FRAGMENT_BYTES));
+
+    // a completed transfer is only repeated, fragments below base were received already and fragments beyond the window are ignored
+    if (is_valid && !bulk->is_complete && (seq >= bulk->base) && (seq < (bulk->base + bulk->window)) && ((offset + width) <= bulk->capacity))
+    {
+      bulk->bitmap[bit >> 3] |= (1 << (bit & 7));
+
+      if (type == BULK_LAST)
+      {
+        bulk->last_seq = (int32_t)seq;
+        bulk->size = offset + width;
+      }
+
+      memcpy(&(bulk->buffer[offset]), &fragment[BULK_HEADER_BYTES], width);
+
+      // base advances over every fragment received in order
+      bit = bulk->base % BULK_MAX_WINDOW;
+
+      while (bulk->bitmap[bit >> 3] & (1 << (bit & 7)))
+      {
+        bulk->bitmap[bit >> 3] &= ~(1 << (bit & 7));
+
+        bulk->base++;
+        bit = bulk->base % BULK_MAX_WINDOW;
+      }
+    }
+
+    if (!bulk->is_complete && (bulk->last_seq >= 0) && (bulk->base > (uint32_t)bulk->last_seq))
+    {
+      bulk->is_complete = true;
+
+      if (message != NULL)
+      {
+        *message = (message_t){ .payload = bulk->buffer, .size = bulk->size, .message_id = 0, .data_pipe = packet->data_pipe };
+      }
+
+    } else {
+
+      status = ERROR;
+    }
+
+  } else if ((status == MSG_MNGR_OK) && (type == BULK_POLL)) {
+
+    // one bitmap ACK is queued for each poll, though the sender repeats it
+    if (seq != bulk->ack_poll_id)
+    {
+      uint8_t ack[BULK_ACK_BYTES];
+      memset(ack, 0, sizeof(ack));
+
+      ack[BULK_HEADER_TYPE] = BULK_ACK;
+      ack[BULK_HEADER_SEQ_LSB] = fragment[BULK_HEADER_SEQ_LSB];
+      ack[BULK_HEADER_SEQ_MSB] = fragment[BULK_HEADER_SEQ_MSB];
+      ack[BULK_HEADER_TRANSFER] = bulk->transfer_id;
+      ack[BULK_ACK_BASE_LSB] = (uint8_t)bulk->base;
+      ack[BULK_ACK_BASE_MSB] = (uint8_t)(bulk->base >> 8);
+
+      // bitmap bit i reports sequence base + i
+      for (uint32_t i = 0; i < bulk->window; i++)
+      {
+        uint32_t bit = (bulk->base + i) % BULK_MAX_WINDOW;
+
+        if (bulk->bitmap[bit >> 3] & (1 << (bit & 7))) { ack[BULK_ACK_BITMAP + (i >> 3)] |= (1 << (i & 7)); }
+      }
+
+      if (bulk->client->ack_payload(packet->data_pipe, ack, sizeof(ack)) == NRF_MNGR_OK) { bulk->ack_poll_id = (uint16_t)seq; }
+    }
+
+    status = ERROR;
+
+  } else {
+
+    status = ERROR;
+  }
+
+  return status;
+}
+
+
+// see message_manager.h
+fn_status_t message_manager_bulk_stats(bulk_manager_t *bulk, uint32_t *retransmitted, uint32_t *goodput) {
+
+  fn_status_t status = (bulk->elapsed_us > 0) ? MSG_MNGR_OK : ERROR;
+
+  if (status == MSG_MNGR_OK)
+  {
+    if (retransmitted != NULL) { *retransmitted = bulk->retransmitted; }
+
+    if (goodput != NULL) { *goodput = (uint32_t)(((uint64_t)bulk->bytes * 1000000) / bulk->elapsed_us); }
+  }
+
+  return status;
+}
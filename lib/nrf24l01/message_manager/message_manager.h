@@ -0,0 +1,285 @@
+/**
+ * Copyright (C) 2021, A. Ridyard.
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License v2.0 as
+ * published by the Free Software Foundation.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * @file message_manager.h
+ * 
+ * @brief type definitions and function declarations for sending
+ * messages larger than one payload, as fragments with a 3 byte
+ * header, and reassembling them, through an nrf_client_t.
+ */
+
+#ifndef MESSAGE_MANAGER_H
+#define MESSAGE_MANAGER_H
+
+#include "error_manager.h"
+#include "nrf24_driver.h"
+
+// fragment header bytes (message ID, fragment index, flags and width)
+#define MESSAGE_HEADER_BYTES 3
+
+// message bytes carried by each fragment
+#define MESSAGE_FRAGMENT_BYTES (MAX_BYTES - MESSAGE_HEADER_BYTES)
+
+// fragments in a message, indexed by one header byte
+#define MESSAGE_MAX_FRAGMENTS 256
+
+// largest message (7424 bytes)
+#define MESSAGE_MAX_BYTES (MESSAGE_MAX_FRAGMENTS * MESSAGE_FRAGMENT_BYTES)
+
+// messages reassembled at the same time, each in its own buffer
+#define MESSAGE_SLOTS 2
+
+// resends of the fragments in a batch which were not acknowledged
+#define MESSAGE_RETRIES 3
+
+// bulk transfer header bytes (type and width, sequence and transfer ID)
+#define BULK_HEADER_BYTES 4
+
+// transfer bytes carried by each bulk transfer fragment
+#define BULK_FRAGMENT_BYTES (MAX_BYTES - BULK_HEADER_BYTES)
+
+// largest bulk transfer window (fragments)
+#define BULK_MAX_WINDOW 128
+
+// fragments in a bulk transfer, numbered by a 16 bit sequence
+#define BULK_MAX_FRAGMENTS 65535
+
+// largest bulk transfer (1834980 bytes)
+#define BULK_MAX_BYTES ((size_t)BULK_MAX_FRAGMENTS * BULK_FRAGMENT_BYTES)
+
+// reassembly of one message, from the fragments received so far
+typedef struct message_slot_s
+{
+  // reassembly buffer, a part of the buffer passed to message_manager_init
+  uint8_t *buffer;
+
+  // message ID and the data pipe it is received on
+  uint8_t message_id;
+  data_pipe_t data_pipe;
+
+  // slot is reassembling a message
+  bool is_active;
+
+  // index of the last fragment, once received (-1 until then)
+  int16_t last_index;
+
+  // fragments received and their message bytes
+  uint16_t received;
+  size_t size;
+
+  // received fragments, one bit for each fragment index
+  uint8_t bitmap[MESSAGE_MAX_FRAGMENTS / 8];
+
+  // time the last fragment was received (us since boot)
+  uint32_t updated_us;
+} message_slot_t;
+
+// fragmentation and reassembly state for one nrf_client_t
+typedef struct message_manager_s
+{
+  // client the fragments are sent and received through
+  nrf_client_t *client;
+
+  // ID of the next message sent
+  uint8_t tx_message_id;
+
+  // reassembly slots and the bytes in each slot buffer
+  message_slot_t slots[MESSAGE_SLOTS];
+  size_t capacity;
+
+  // time after its last fragment, before a message is discarded (us)
+  uint32_t timeout_us;
+
+  // messages discarded, as incomplete after timeout_us or too large (counted by message_manager_receive)
+  uint32_t discarded;
+} message_manager_t;
+
+// a reassembled message
+typedef struct message_s
+{
+  // message bytes, valid until the next message_manager_receive
+  const uint8_t *payload;
+
+  // message bytes
+  size_t size;
+
+  // message ID and the data pipe it was received on
+  uint8_t message_id;
+  data_pipe_t data_pipe;
+} message_t;
+
+// selective repeat bulk transfer state, for a sender or a receiver
+typedef struct bulk_manager_s
+{
+  // client the fragments are sent and received through
+  nrf_client_t *client;
+
+  // fragments in flight and fragments sent between bitmap ACK polls
+  uint16_t window;
+  uint16_t ack_interval;
+
+  // ID of the last poll sent and of the last poll an ACK payload was queued for
+  uint16_t poll_id;
+  uint16_t ack_poll_id;
+
+  // ID of the transfer sent or received, carried in every fragment and poll
+  uint8_t transfer_id;
+
+  // receive buffer and its size (NULL for a sender)
+  uint8_t *buffer;
+  size_t capacity;
+
+  // receiver, lowest missing sequence and the sequence of the last fragment (-1 until received)
+  uint32_t base;
+  int32_t last_seq;
+
+  // receiver, transfer bytes, once the last fragment is received and transfer completed flag
+  size_t size;
+  bool is_complete;
+
+  // receiver, fragments received above base, one bit for each sequence (modulo BULK_MAX_WINDOW)
+  uint8_t bitmap[BULK_MAX_WINDOW / 8];
+
+  // sender, fragments transmitted and retransmitted in the last transfer
+  uint32_t transmitted;
+  uint32_t retransmitted;
+
+  // sender, packets read whilst polling, which were not a bitmap ACK
+  uint32_t discarded;
+
+  // sender, bytes and duration of the last transfer (us)
+  size_t bytes;
+  uint32_t elapsed_us;
+} bulk_manager_t;
+
+
+/**
+ * Initialises a message_manager_t for a client. The buffer is
+ * divided between MESSAGE_SLOTS reassembly slots, so at most
+ * (size / MESSAGE_SLOTS) bytes are accepted in a message.
+ * 
+ * @param manager message_manager_t struct
+ * @param client nrf_client_t, which is configured and initialised
+ * @param buffer reassembly buffer
+ * @param size size of buffer
+ * @param timeout_us time after its last fragment, before an incomplete message is discarded (us)
+ * 
+ * @return MSG_MNGR_OK (4), ERROR (0)
+ */
+fn_status_t message_manager_init(message_manager_t *manager, nrf_client_t *client, uint8_t *buffer, size_t size, uint32_t timeout_us);
+
+
+/**
+ * Sends a message of up to MESSAGE_MAX_BYTES, as fragments of
+ * MAX_BYTES, each with a 3 byte header. Fragments are staged in
+ * batches and sent through send_stream, so the TX FIFO is kept
+ * full. Only the fragments of a batch which were not acknowledged
+ * are resent, up to MESSAGE_RETRIES times. The last fragment is 
+ * padded to MAX_BYTES, so receivers with static payloads 
+ * (payload_size of MAX_BYTES) also work.
+ * 
+ * @param manager message_manager_t struct
+ * @param message message bytes
+ * @param size size of message
+ * 
+ * @return MSG_MNGR_OK (4) if every fragment was acknowledged, ERROR (0)
+ */
+fn_status_t message_manager_send(message_manager_t *manager, const void *message, size_t size);
+
+
+/**
+ * Adds a received packet to the reassembly of its message and
+ * passes the message to message, once its last missing fragment
+ * is received. Incomplete messages are discarded timeout_us after
+ * their last fragment, or if a message needs a slot and none is
+ * free, in which case the oldest is discarded. Timeouts are 
+ * checked on each call, so discarded is only updated whilst 
+ * packets are passed to message_manager_receive.
+ * 
+ * @param manager message_manager_t struct
+ * @param packet received packet (see nrf_driver_rx_ring_pop)
+ * @param message message_t struct for a completed message
+ * 
+ * @return MSG_MNGR_OK (4) if a message was completed, ERROR (0)
+ */
+fn_status_t message_manager_receive(message_manager_t *manager, const rx_packet_t *packet, message_t *message);
+
+
+/**
+ * Initialises a bulk_manager_t for a client. ACK payloads must be
+ * enabled (ack_payloads_enable) on both the sender and receiver.
+ * 
+ * @param bulk bulk_manager_t struct
+ * @param client nrf_client_t, which is configured and initialised
+ * @param buffer receive buffer or NULL, for a sender
+ * @param size size of buffer
+ * @param window fragments in flight, 1 - BULK_MAX_WINDOW
+ * @param ack_interval fragments sent between bitmap ACK polls, 1 - window
+ * 
+ * @return MSG_MNGR_OK (4), ERROR (0)
+ */
+fn_status_t message_manager_bulk_init(bulk_manager_t *bulk, nrf_client_t *client, uint8_t *buffer, size_t size, uint16_t window, uint16_t ack_interval);
+
+
+/**
+ * Sends up to BULK_MAX_BYTES through a selective repeat sliding
+ * window. Fragments are sent without auto-acknowledgement through
+ * send_stream_noack and, after every ack_interval fragments, a poll
+ * is sent with auto-acknowledgement, which returns a bitmap ACK 
+ * from the receiver as an ACK payload. Only fragments missing from
+ * the bitmap are retransmitted. Each transfer has a new transfer 
+ * ID, so the receiver starts again after an aborted transfer.
+ * 
+ * @note Packets are read from the RX FIFO whilst polling, for the
+ * bitmap ACK. Any other packet read is discarded (and counted in
+ * discarded), so the client must not expect other packets whilst
+ * a transfer is sent.
+ * 
+ * @param bulk bulk_manager_t struct
+ * @param data transfer bytes
+ * @param size size of data
+ * 
+ * @return MSG_MNGR_OK (4) if every fragment was received, ERROR (0)
+ */
+fn_status_t message_manager_bulk_send(bulk_manager_t *bulk, const void *data, size_t size);
+
+
+/**
+ * Adds a received packet to a bulk transfer. Fragments are written
+ * to the receive buffer and a poll queues a bitmap ACK of the 
+ * fragments received, as an ACK payload, returned with the next 
+ * auto-acknowledgement of the poll. The transfer is passed to 
+ * message, once every fragment is received. A fragment or poll
+ * with a new transfer ID discards the transfer received so far.
+ * 
+ * @param bulk bulk_manager_t struct
+ * @param packet received packet (see nrf_driver_rx_ring_pop)
+ * @param message message_t struct for a completed transfer
+ * 
+ * @return MSG_MNGR_OK (4) if the transfer was completed, ERROR (0)
+ */
+fn_status_t message_manager_bulk_receive(bulk_manager_t *bulk, const rx_packet_t *packet, message_t *message);
+
+
+/**
+ * Reports the fragments retransmitted and the goodput (transfer 
+ * bytes per second) of the last message_manager_bulk_send.
+ * 
+ * @param bulk bulk_manager_t struct
+ * @param retransmitted fragments retransmitted or NULL
+ * @param goodput transfer bytes per second or NULL
+ * 
+ * @return MSG_MNGR_OK (4), ERROR (0) if no transfer has completed
+ */
+fn_status_t message_manager_bulk_stats(bulk_manager_t *bulk, uint32_t *retransmitted, uint32_t *goodput);
+
+#endif // MESSAGE_MANAGER_H
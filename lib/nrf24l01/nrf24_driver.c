@@ -17,24 +17,39 @@
 #include <string.h>
 #include "pin_manager.h"
 #include "spi_manager.h"
+#include "pio_manager.h"
 #include "device_config.h"
 #include "nrf24_driver.h"
+#include "hardware/sync.h"
+#include "pico/multicore.h"
 
 typedef enum device_mode_e
 {
   STANDBY_I,
   STANDBY_II,
   TX_MODE,
-  RX_MODE
+  RX_MODE,
+  POWER_DOWN
 } device_mode_t;
 
+// phases of a duty-cycled receive period, in order
+typedef enum duty_phase_e
+{
+  DUTY_WAKE,
+  DUTY_LISTEN,
+  DUTY_READY,
+  DUTY_SLEEP,
+  DUTY_STOP // powering up to Standby-I, after nrf_driver_duty_cycle_stop
+} duty_phase_t;
+
 /**
- * A global struct, which encapsulates pin_manager_t and spi_manager_t 
- * objects, which hold data relevant to the pin_manager, spi_manager 
- * utility functions. The nrf_manager_t holds register configuration
- * settings for the NRF24L01.
+ * Driver instance struct, which encapsulates pin_manager_t and 
+ * spi_manager_t objects, which hold data relevant to the pin_manager, 
+ * spi_manager utility functions. The nrf_manager_t holds register 
+ * configuration settings for the NRF24L01. One nrf_driver_t is held 
+ * for each NRF24L01 (see nrf_drivers).
  */
-typedef struct nrf_driver_s
+struct nrf_driver_s
 {
   // GPIO pin numbers
   pin_manager_t user_pins;
@@ -42,6 +57,9 @@ typedef struct nrf_driver_s
   // SPI interface and baudrate
   spi_manager_t user_spi;
 
+  // PIO state machine, used in place of the SPI interface
+  pio_manager_t user_pio;
+
   // NRF register configuration
   nrf_manager_t user_config;
 
@@ -51,21 +69,138 @@ typedef struct nrf_driver_s
   // STANDBY_I, STANDBY_II, TX_MODE, RX_MODE
   device_mode_t mode;
 
+  // shadow of the single byte configuration registers, indexed by register address
+  uint8_t shadow[FEATURE + 1];
+
   // RX_ADDR_P0 register cache flag
   bool is_rx_addr_p0;
 
   // RX_ADDR_P0 register value cache
   uint8_t rx_addr_p0[5];
 
-} nrf_driver_t;
+  // RX_ADDR_P0 register overwritten by tx_destination, restored by receiver_mode flag
+  bool is_rx_addr_p0_stale;
+
+  // SPI session open flag
+  bool is_spi_session;
+
+  // SPI session uses the PIO state machine flag
+  bool is_pio_spi;
+
+  // instance is bound to an nrf_client_t flag
+  bool is_bound;
+
+  // IRQ pin with a falling edge interrupt enabled (IRQ_PIN_UNUSED if none)
+  uint8_t irq_pin;
+
+  // IRQ pin interrupt latched, STATUS register not yet read flag
+  volatile bool is_irq_pending;
+
+  // raw GPIO IRQ handler for the instance (see NRF_DRIVER_BIND)
+  void (*irq_handler)(void);
+
+  // packet sent by send_packet_async awaiting TX_DS or MAX_RT flag
+  bool is_tx_pending;
+
+  // send_packet_async completion callback and its user data
+  tx_callback_t tx_callback;
+  void *tx_user_data;
+
+  // STATUS register value, as last clocked in by a command (see track_status)
+  uint8_t status_reg;
+
+  // IRQ bits reset by check_status_events, held until consumed (fn_status_event_t)
+  uint8_t events;
+
+  // SPI transfers in progress through the PIO state machine (see hold_spi)
+  volatile uint8_t spi_busy;
+
+  // RX ring slots, supplied by nrf_driver_rx_ring (NULL if disabled)
+  rx_packet_t *volatile rx_ring;
+
+  // number of RX ring slots (power of 2)
+  size_t rx_ring_depth;
+
+  // free running RX ring indices, head written by drain_rx_ring and tail by nrf_driver_rx_ring_pop
+  volatile uint32_t rx_ring_head;
+  volatile uint32_t rx_ring_tail;
+
+  // packets discarded, as the RX ring was full
+  volatile uint32_t rx_ring_overflows;
+
+  // TX queue entries and results, supplied by nrf_driver_tx_queue (NULL if disabled)
+  tx_entry_t *volatile tx_queue;
+  tx_result_t *tx_results;
+
+  // number of TX queue entries and results (power of 2)
+  size_t tx_queue_depth;
+
+  /**
+   * free running TX queue indices, head written by nrf_driver_tx_enqueue,
+   * upload (next entry for the TX FIFO) and tail (oldest entry in flight) 
+   * by pump_tx_queue. The index of an entry is its sequence number.
+   */
+  volatile uint32_t tx_queue_head;
+  volatile uint32_t tx_queue_upload;
+  volatile uint32_t tx_queue_tail;
+
+  // free running TX results indices, head written by pump_tx_queue and tail by nrf_driver_tx_result
+  volatile uint32_t tx_results_head;
+  volatile uint32_t tx_results_tail;
+
+  // radio engine requested to run on core 1 and running flags
+  volatile bool is_engine;
+  volatile bool is_engine_running;
+
+  // beacon retransmitted by beacon_timer flag
+  volatile bool is_beacon;
+
+  // beacon payload update in progress, beacon_callback skips its CE pulse
+  volatile bool is_beacon_update;
+
+  // time of the last beacon CE pulse (us since boot)
+  volatile uint32_t beacon_pulse_us;
+
+  // repeating timer, which pulses CE for each beacon transmission
+  repeating_timer_t beacon_timer;
+
+  // alarm, which completes the 130us RX Mode settling time (0 if none)
+  volatile alarm_id_t rx_settle_alarm;
+
+  // RX Mode settling time completed, RX_READY_EVENT not yet reported flag
+  volatile bool is_rx_ready;
+
+  // CE pulse width (us), to start a transmission
+  uint32_t ce_pulse_us;
+
+  // alarm, which ends a CE pulse (0 if none)
+  volatile alarm_id_t ce_pulse_alarm;
+
+  // duty-cycled receive flag and its current phase
+  volatile bool is_duty_cycle;
+  volatile duty_phase_t duty_phase;
+
+  // duty cycle period and listen window (us)
+  uint32_t duty_period_us;
+  uint32_t duty_listen_us;
+
+  // alarm, which advances the duty cycle phases (0 if none)
+  volatile alarm_id_t duty_alarm;
+};
+
+// minimum CE pulse width, which starts a transmission (us)
+#define CE_PULSE_US 10
+
+// irq_pin value with no IRQ pin, as GPIO 0 is a valid IRQ pin
+#define IRQ_PIN_UNUSED 0xFF
 
 
 /**
- * global nrf_driver_t struct, initialised
- * with default values for user_spi and
- * user_config structs and for mode value
+ * nrf_driver_t struct with default values for 
+ * user_spi and user_config structs and for mode
+ * value, copied into an instance when it is bound
  */
-nrf_driver_t nrf_driver = { 
+static const nrf_driver_t nrf_driver_default = { 
   .user_spi.baudrate = 7000000,
   .user_spi.instance = spi0,
   .user_config.address_width = AW_5_BYTES,
@@ -78,9 +213,86 @@ nrf_driver_t nrf_driver = {
   .address_width_bytes = FIVE_BYTES,
   .is_rx_addr_p0 = false,
   .rx_addr_p0 = { 0x00, 0x00, 0x00, 0x00, 0x00 },
+  .is_rx_addr_p0_stale = false,
+  .is_spi_session = false,
+  .is_pio_spi = false,
+  .is_bound = false,
+  .irq_pin = IRQ_PIN_UNUSED,
+  .is_irq_pending = false,
+  .is_tx_pending = false,
+  .tx_callback = NULL,
+  .tx_user_data = NULL,
+  .status_reg = STATUS_RX_P_NO_MASK << STATUS_RX_P_NO,
+  .events = NO_EVENTS,
+  .spi_busy = 0,
+  .rx_ring = NULL,
+  .rx_ring_depth = 0,
+  .rx_ring_head = 0,
+  .rx_ring_tail = 0,
+  .rx_ring_overflows = 0,
+  .tx_queue = NULL,
+  .tx_results = NULL,
+  .tx_queue_depth = 0,
+  .tx_queue_head = 0,
+  .tx_queue_upload = 0,
+  .tx_queue_tail = 0,
+  .tx_results_head = 0,
+  .tx_results_tail = 0,
+  .is_engine = false,
+  .is_engine_running = false,
+  .is_beacon = false,
+  .is_beacon_update = false,
+  .beacon_pulse_us = 0,
+  .rx_settle_alarm = 0,
+  .is_rx_ready = false,
+  .ce_pulse_us = CE_PULSE_US,
+  .ce_pulse_alarm = 0,
+  .is_duty_cycle = false,
+  .duty_phase = DUTY_WAKE,
+  .duty_period_us = 0,
+  .duty_listen_us = 0,
+  .duty_alarm = 0,
   .mode = STANDBY_I
 };
 
+// number of registers held in nrf_driver_t shadow
+#define SHADOW_REGISTERS 15
+
+// registers held in nrf_driver_t shadow
+static const register_map_t shadow_registers[SHADOW_REGISTERS] = {
+  CONFIG, EN_AA, EN_RXADDR, SETUP_AW, SETUP_RETR, RF_CH, RF_SETUP,
+  RX_PW_P0, RX_PW_P1, RX_PW_P2, RX_PW_P3, RX_PW_P4, RX_PW_P5,
+  DYNPD, FEATURE
+};
+
+/**
+ * longest beacon transmission after a CE pulse (us), which is 
+ * 130us TX settling and a 32 byte payload, with a 5 byte address 
+ * and 2 byte CRC, at 250kbps, rounded up
+ */
+#define BEACON_AIRTIME_US 1500
+
+// NRF24L01 RX Mode settling time, after CE is driven HIGH (us)
+#define RX_SETTLE_US 130
+
+// NRF24L01 Power Down to Standby-I time, after PWR_UP is set (us)
+#define POWER_UP_US 1500
+
+// delay before a duty cycle phase is retried, whilst the SPI interface is in use (us)
+#define DUTY_RETRY_US 50
+
+// longest wait for the outcome of a packet, beyond 15 retransmits with a 4000μS ARD
+#define TX_TIMEOUT_US 100000
+
+// wait between radio engine passes, whilst there is nothing pending (us)
+#define ENGINE_POLL_US 50
+
+// driver instances, one for each NRF24L01
+static nrf_driver_t nrf_drivers[NRF_DRIVER_MAX_INSTANCES];
+
+// instance run by the radio engine on core 1 (see nrf_driver_engine_start)
+static nrf_driver_t *engine_driver = NULL;
+
 
 /**
  * forward declaration of static utility functions, 
@@ -88,15 +300,69 @@ nrf_driver_t nrf_driver = {
  */
 static fn_status_t validate_config(nrf_manager_t *user_config);
 
-static fn_status_t w_register(register_map_t reg, const void *buffer, size_t buffer_size);
+static void close_spi_session(nrf_driver_t *driver);
+
+static fn_status_t spi_transfer(nrf_driver_t *driver, const uint8_t *tx_buffer, uint8_t *rx_buffer, size_t len);
+
+static void hold_spi(nrf_driver_t *driver);
+
+static void release_spi(nrf_driver_t *driver);
+
+static bool is_spi_held(nrf_driver_t *driver);
+
+static fn_status_t spi_write_command(nrf_driver_t *driver, uint8_t command, const void *buffer, size_t len, uint8_t *status_reg);
+
+static fn_status_t spi_transfer_batch(nrf_driver_t *driver, const spi_manager_frame_t *frames, size_t count);
+
+static void track_status(nrf_driver_t *driver, uint8_t command, uint8_t value, const uint8_t *status_reg);
+
+static fn_status_t w_register(nrf_driver_t *driver, register_map_t reg, const void *buffer, size_t buffer_size);
+
+static fn_status_t w_shadow_register(nrf_driver_t *driver, register_map_t reg, uint8_t value);
+
+static uint8_t r_register_byte(nrf_driver_t *driver, register_map_t reg);
+
+static uint8_t check_status_events(nrf_driver_t *driver, uint8_t *rx_p_no);
 
-static uint8_t r_register_byte(register_map_t reg);
+static uint8_t poll_status_events(nrf_driver_t *driver, uint8_t *rx_p_no);
 
-static fn_status_irq_t check_status_irq(uint8_t *rx_p_no);
+static uint8_t consume_events(nrf_driver_t *driver, uint8_t events);
 
-static void flush_tx_fifo(void);
+static fn_status_irq_t complete_tx(nrf_driver_t *driver, tx_status_t *tx_status);
 
-static void flush_rx_fifo(void);
+static size_t complete_tx_fifo(nrf_driver_t *driver, size_t in_flight, fn_status_irq_t *outcomes);
+
+static fn_status_t configure_irq(nrf_driver_t *driver);
+
+static void irq_handler(nrf_driver_t *driver);
+
+static void drain_rx_ring(nrf_driver_t *driver);
+
+static void pump_tx_queue(nrf_driver_t *driver);
+
+static void engine_main(void);
+
+static bool is_tx_idle(nrf_driver_t *driver);
+
+static bool beacon_callback(repeating_timer_t *timer);
+
+static void wait_beacon_airtime(nrf_driver_t *driver);
+
+static int64_t rx_settle_callback(alarm_id_t id, void *user_data);
+
+static void cancel_rx_settle(nrf_driver_t *driver);
+
+static void pulse_ce(nrf_driver_t *driver);
+
+static int64_t ce_pulse_callback(alarm_id_t id, void *user_data);
+
+static void cancel_ce_pulse(nrf_driver_t *driver);
+
+static int64_t duty_cycle_callback(alarm_id_t id, void *user_data);
+
+static uint8_t r_status(nrf_driver_t *driver);
+
+static void flush_rx_fifo(nrf_driver_t *driver);
 
 
 /***********************************
@@ -108,19 +374,24 @@ static void flush_rx_fifo(void);
  * Validate and configure GPIO pins and ascertain the 
  * correct SPI instance, if the pins are valid. Store 
  * GPIO and SPI details in the pin_manager_t user_pins
- * and spi_manager user_spi structs, within the global 
- * nrf_driver_t nrf_driver struct.
+ * and spi_manager user_spi structs, within the 
+ * nrf_driver_t driver struct.
+ * 
+ * An SPI session is opened on the SPI instance, which 
+ * stays open for use by all other driver functions, 
+ * until nrf_driver_close is called.
  * 
  * @note The function returns ERROR, if the pins were 
  * not valid, possibly due to one SPI pin using SPI 0 
  * interface and another using SPI 1.
  * 
+ * @param driver nrf_driver_t instance
  * @param user_pins pin_manager_t struct of pin numbers
  * @param baudrate_hz baudrate in Hz
  * 
  * @return PI_MNGR_OK (1), ERROR (0)
  */
-fn_status_t nrf_driver_configure(pin_manager_t *user_pins, uint32_t baudrate_hz) {
+fn_status_t nrf_driver_configure(nrf_driver_t *driver, pin_manager_t *user_pins, uint32_t baudrate_hz) {
 
   // validate GPIO pins: PIN_MNGR_OK (1) or ERROR (0)
   fn_status_t status = pin_manager_configure(
@@ -133,9 +404,9 @@ fn_status_t nrf_driver_configure(pin_manager_t *user_pins, uint32_t baudrate_hz)
 
   if (status == PIN_MNGR_OK)
   {
-    pin_manager_t *pins = &(nrf_driver.user_pins);
+    pin_manager_t *pins = &(driver->user_pins);
 
-    // store user_pins in global nrf_driver struct
+    // store user_pins in driver struct
     *pins = *user_pins;
 
     spi_instance_t instance_pattern[8] = { SPI_0, SPI_0, SPI_1, SPI_1, SPI_0, SPI_0, SPI_1, SPI_1 };
@@ -159,11 +430,22 @@ fn_status_t nrf_driver_configure(pin_manager_t *user_pins, uint32_t baudrate_hz)
 
     if (status == PIN_MNGR_OK)
     {
-      spi_manager_t *spi = &(nrf_driver.user_spi);
+      spi_manager_t *spi = &(driver->user_spi);
+
+      // close an SPI session held from a previous configuration
+      close_spi_session(driver);
 
-      // store baudrate & SPI instance in global nrf_driver
+      // store baudrate & SPI instance in driver struct
       spi->baudrate = (baudrate_hz > 7500000) ? 7500000 : baudrate_hz;
       spi->instance = (count[SPI_0] == 3) ? spi0 : spi1;
+
+      // SPI session stays open until nrf_driver_close is called
+      status = (spi_manager_open(spi->instance, spi->baudrate)) ? PIN_MNGR_OK : ERROR;
+
+      driver->is_spi_session = (status == PIN_MNGR_OK);
+      driver->is_pio_spi = false;
+
+      if (status == PIN_MNGR_OK) { status = configure_irq(driver); }
     }
   }
 
@@ -171,6 +453,64 @@ fn_status_t nrf_driver_configure(pin_manager_t *user_pins, uint32_t baudrate_hz)
 }
 
 
+/**
+ * Validate and configure GPIO pins for the PIO SPI transport, 
+ * in place of the SPI interface. Store GPIO details in the 
+ * pin_manager_t user_pins struct and the baudrate in the 
+ * spi_manager_t user_spi struct, within the 
+ * nrf_driver_t driver struct.
+ * 
+ * A PIO state machine is claimed and clocks each transfer 
+ * to the NRF24L01, driving CSN itself. Any GPIO pins can be
+ * used, leaving the SPI interfaces free for other devices.
+ * The state machine is held until nrf_driver_close is called.
+ * 
+ * @note The function returns ERROR, if a pin number is used
+ * more than once, or no PIO state machine is available.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param user_pins pin_manager_t struct of pin numbers
+ * @param baudrate_hz baudrate in Hz
+ * 
+ * @return PIN_MNGR_OK (1), ERROR (0)
+ */
+fn_status_t nrf_driver_configure_pio(nrf_driver_t *driver, pin_manager_t *user_pins, uint32_t baudrate_hz) {
+
+  // validate GPIO pins: PIN_MNGR_OK (1) or ERROR (0)
+  fn_status_t status = pin_manager_configure_pio(
+    user_pins->copi, 
+    user_pins->cipo, 
+    user_pins->sck, 
+    user_pins->csn, 
+    user_pins->ce
+  );
+
+  if (status == PIN_MNGR_OK)
+  {
+    // close an SPI session held from a previous configuration
+    close_spi_session(driver);
+
+    // store user_pins in driver struct
+    driver->user_pins = *user_pins;
+
+    spi_manager_t *spi = &(driver->user_spi);
+
+    // store baudrate in driver struct
+    spi->baudrate = (baudrate_hz > 7500000) ? 7500000 : baudrate_hz;
+
+    // PIO state machine is held until nrf_driver_close is called
+    status = (pio_manager_init(&(driver->user_pio), user_pins->copi, user_pins->cipo, user_pins->sck, user_pins->csn, spi->baudrate)) ? PIN_MNGR_OK : ERROR;
+
+    driver->is_spi_session = (status == PIN_MNGR_OK);
+    driver->is_pio_spi = driver->is_spi_session;
+
+    if (status == PIN_MNGR_OK) { status = configure_irq(driver); }
+  }
+
+  return status;
+}
+
+
 /**
  * Initialise NRF24L01 registers, leaving the device in 
  * Standby Mode.
@@ -192,16 +532,12 @@ fn_status_t nrf_driver_configure(pin_manager_t *user_pins, uint32_t baudrate_hz)
  * Dynamic payload: disabled
  * Acknowledgment payload: disabled
  * 
+ * @param driver nrf_driver_t instance
  * @param user_config channel
  * 
  * @return SPI_MNGR_OK (2), ERROR (0)
  */
-fn_status_t nrf_driver_initialise(nrf_manager_t *user_config) {
-
-  spi_manager_t *spi = &(nrf_driver.user_spi);
-
-  // initialise SPI for function duration
-  spi_manager_init_spi(spi->instance, spi->baudrate); 
+fn_status_t nrf_driver_initialise(nrf_driver_t *driver, nrf_manager_t *user_config) {
 
   /** with a VDD of 1.9V or higher, nRF24L01+ enters the Power on reset state **/
 
@@ -210,16 +546,17 @@ fn_status_t nrf_driver_initialise(nrf_manager_t *user_config) {
   /** NRF24L01 is now in Power Down mode. PWR_UP bit in the CONFIG register is unset (0) **/
 
   // CE to LOW in preperation for entering Standby-I mode
-  ce_put_low(nrf_driver.user_pins.ce); 
+  ce_put_low(driver->user_pins.ce); 
 
   sleep_ms(1);
 
   // CSN high in preperation for writing to registers
-  csn_put_high(nrf_driver.user_pins.csn); 
+  csn_put_high(driver->user_pins.csn); 
 
-  nrf_manager_t *config = &(nrf_driver.user_config);
+  nrf_manager_t *config = &(driver->user_config);
 
-  fn_status_t status = ERROR;
+  // NULL user_config uses the default configuration
+  fn_status_t status = NRF_MNGR_OK;
 
   // if nrf_manager_t user_config !== NULL
   if (user_config != NULL)
@@ -231,73 +568,51 @@ fn_status_t nrf_driver_initialise(nrf_manager_t *user_config) {
       // store user_config in global nrf_driver_t object
       *config = *user_config;
 
-      nrf_driver.address_width_bytes = ((config->address_width + 2) <= FIVE_BYTES) ? config->address_width + 2 : FIVE_BYTES;
+      driver->address_width_bytes = ((config->address_width + 2) <= FIVE_BYTES) ? config->address_width + 2 : FIVE_BYTES;
     }
   }
 
   if (status == NRF_MNGR_OK)
   {
-    // register address and value to write
-    typedef struct w_register_s { register_map_t reg; uint8_t buf[1]; } w_register_t;
-
-    // array of register addresses and values
-    w_register_t register_list[9] = {
-      (w_register_t){ 
-        .reg = CONFIG,
-        .buf = { 0x0E } // set PWR_UP bit
-      },
-      (w_register_t){ 
-        .reg = EN_AA, // enable auto-acknowledge
-        .buf = { ENAA_ALL } // on all data pipes
-      },
-      (w_register_t){ 
-        .reg = SETUP_AW, // set address width
-        .buf = { config->address_width } 
-      },
-      (w_register_t){ 
-        .reg = SETUP_RETR, // retransmission settings
-        .buf = { config->retr_count | config->retr_delay } 
-      },
-      (w_register_t){ 
-        .reg = RF_CH, // set RF channel
-        .buf = { config->channel} 
-      },
-      (w_register_t){ 
-        .reg = RF_SETUP, // RF data rate & TX power level  
-        .buf = { config->data_rate | config->power } 
-      },
-      (w_register_t){ 
-        .reg = FEATURE, // enable dynamic payloads in FEATURE register
-        .buf = { SET_BIT << FEATURE_EN_DPL | SET_BIT << FEATURE_EN_DYN_ACK } 
-      },
-      (w_register_t){ 
-        .reg = DYNPD, // dynamic payloads register
-        .buf = { config->dyn_payloads } // DYNPD_ENABLE, DYNPD_DISABLE
-      },
-      (w_register_t){ 
-        .reg = STATUS, 
-        .buf = { STATUS_INTERRUPT_MASK } // clear STATUS interrupt bits
-      },
-    };
-    
-    // write the buffer to each register address
-    for (size_t i = 0; i < 8; i++)
+    uint8_t *shadow = driver->shadow;
+
+    // shadow holds the value written to each register
+    shadow[CONFIG] = 0x0E; // set PWR_UP bit
+    shadow[EN_AA] = ENAA_ALL; // enable auto-acknowledge on all data pipes
+    shadow[EN_RXADDR] = 0x03; // data pipes 0 & 1 enabled (reset value)
+    shadow[SETUP_AW] = config->address_width;
+    shadow[SETUP_RETR] = config->retr_count | config->retr_delay;
+    shadow[RF_CH] = config->channel;
+    shadow[RF_SETUP] = config->data_rate | config->power;
+    shadow[DYNPD] = config->dyn_payloads; // DYNPD_ENABLE, DYNPD_DISABLE
+    shadow[FEATURE] = SET_BIT << FEATURE_EN_DPL | SET_BIT << FEATURE_EN_DYN_ACK;
+
+    // RX_PW_P0 - RX_PW_P5 unused (reset value), until set by payload_size
+    for (size_t i = 0; i < ALL_DATA_PIPES; i++) { shadow[RX_PW_P0 + i] = 0; }
+
+    // W_REGISTER command + value for each register, STATUS, FLUSH_TX and FLUSH_RX
+    uint8_t tx_buffers[SHADOW_REGISTERS][TWO_BYTES];
+    spi_manager_frame_t frames[SHADOW_REGISTERS + 3];
+
+    for (size_t i = 0; i < SHADOW_REGISTERS; i++)
     {
-      status = w_register(register_list[i].reg, register_list[i].buf, ONE_BYTE);
+      tx_buffers[i][0] = (REGISTER_MASK & shadow_registers[i]) | W_REGISTER;
+      tx_buffers[i][1] = shadow[shadow_registers[i]];
 
-      // Crystal oscillator start up delay (Power Down to Standby-I state)
-      if (register_list[i].reg == CONFIG) { sleep_ms(5); }
-
-      if (status == ERROR) { break; } // break on error
+      frames[i] = (spi_manager_frame_t){ .tx_buffer = tx_buffers[i], .rx_buffer = NULL, .len = TWO_BYTES };
     }
 
-    // flush RX and TX FIFOs
-    flush_tx_fifo();
-    flush_rx_fifo();
-  }
+    // clear STATUS interrupt bits
+    frames[SHADOW_REGISTERS] = (spi_manager_frame_t){ .tx_buffer = (uint8_t[]){ STATUS | W_REGISTER, STATUS_INTERRUPT_MASK }, .rx_buffer = NULL, .len = TWO_BYTES };
+    frames[SHADOW_REGISTERS + 1] = (spi_manager_frame_t){ .tx_buffer = (uint8_t[]){ FLUSH_TX }, .rx_buffer = NULL, .len = ONE_BYTE };
+    frames[SHADOW_REGISTERS + 2] = (spi_manager_frame_t){ .tx_buffer = (uint8_t[]){ FLUSH_RX }, .rx_buffer = NULL, .len = ONE_BYTE };
 
-  // deinitialise SPI at function end
-  spi_manager_deinit_spi(spi->instance); 
+    // write every register and flush RX and TX FIFOs in one batch
+    status = spi_transfer_batch(driver, frames, SHADOW_REGISTERS + 3);
+
+    // Crystal oscillator start up delay (Power Down to Standby-I state)
+    sleep_ms(5);
+  }
 
   return status;
 }
@@ -317,16 +632,12 @@ fn_status_t nrf_driver_initialise(nrf_manager_t *user_config) {
  * This driver uses auto-acknowledgement by default and this function 
  * writes the address to the the RX_ADDR_P0 by design.
  * 
+ * @param driver nrf_driver_t instance
  * @param address (uint8_t[]){0x37, 0x37, 0x37, 0x37, 0x37} etc.
  * 
  * @return SPI_MNGR_OK (2), ERROR (0)
  */
-fn_status_t nrf_driver_tx_destination(const uint8_t *buffer) {
-
-  spi_manager_t *spi = &(nrf_driver.user_spi);
-
-  // initialise SPI for function duration
-  spi_manager_init_spi(spi->instance, spi->baudrate);
+fn_status_t nrf_driver_tx_destination(nrf_driver_t *driver, const uint8_t *buffer) {
 
   register_map_t registers[2] = { RX_ADDR_P0, TX_ADDR };
 
@@ -336,13 +647,16 @@ fn_status_t nrf_driver_tx_destination(const uint8_t *buffer) {
 
   for (size_t i = 0; i < 2; i++)
   {
-    status = w_register(registers[i], buffer, nrf_driver.address_width_bytes);
+    status = w_register(driver, registers[i], buffer, driver->address_width_bytes);
 
     if (status == ERROR) { break; }
   }
 
-  // deinitialise SPI at function end
-  spi_manager_deinit_spi(spi->instance); 
+  // cached RX_ADDR_P0 address is only restored by receiver_mode, if it differs
+  if (driver->is_rx_addr_p0 && memcmp(driver->rx_addr_p0, buffer, driver->address_width_bytes))
+  {
+    driver->is_rx_addr_p0_stale = true;
+  }
 
   return status;
 }
@@ -357,15 +671,12 @@ fn_status_t nrf_driver_tx_destination(const uint8_t *buffer) {
  * NOTE: If you do use a 5 byte buffer for data pipes 2 - 5, then the 
  * function will only write one byte (buffer[0]).
  * 
+ * @param driver nrf_driver_t instance
  * @param address (uint8_t[]){0x37, 0x37, 0x37, 0x37, 0x37} etc.
  * 
  * @return SPI_MNGR_OK (2), ERROR (0)
  */
-fn_status_t nrf_driver_rx_destination(data_pipe_t data_pipe, const uint8_t *buffer) {
-
-  spi_manager_t *spi = &(nrf_driver.user_spi);
-
-  spi_manager_init_spi(spi->instance, spi->baudrate);
+fn_status_t nrf_driver_rx_destination(nrf_driver_t *driver, data_pipe_t data_pipe, const uint8_t *buffer) {
 
   uint8_t registers[6] = {
     RX_ADDR_P0, RX_ADDR_P1, RX_ADDR_P2,
@@ -375,10 +686,13 @@ fn_status_t nrf_driver_rx_destination(data_pipe_t data_pipe, const uint8_t *buff
   if (data_pipe == DATA_PIPE_0)
   {
     // set RX_ADDR_P0 cache flag
-    nrf_driver.is_rx_addr_p0 = true;
+    driver->is_rx_addr_p0 = true;
 
     // cache RX_ADDR_P0 address
-    memcpy(nrf_driver.rx_addr_p0, buffer, nrf_driver.address_width_bytes);
+    memcpy(driver->rx_addr_p0, buffer, driver->address_width_bytes);
+
+    // RX_ADDR_P0 is written below
+    driver->is_rx_addr_p0_stale = false;
   }
 
   // will hold OK (0) or REGISTER_W_FAIL (3)
@@ -389,26 +703,23 @@ fn_status_t nrf_driver_rx_destination(data_pipe_t data_pipe, const uint8_t *buff
   {
     if (data_pipe < DATA_PIPE_2) // DATA_PIPE_0 & DATA_PIPE_1 hold full address width
     {
-      status = w_register(registers[data_pipe], buffer, nrf_driver.address_width_bytes);
+      status = w_register(driver, registers[data_pipe], buffer, driver->address_width_bytes);
 
     } else {  // DATA_PIPE_2 - DATA_PIPE_5 hold 1 byte + 4 MSB of DATA_PIPE_1
 
-      status = w_register(registers[data_pipe], buffer, ONE_BYTE);
+      status = w_register(driver, registers[data_pipe], buffer, ONE_BYTE);
     }
 
-    // read value of EN_RXADDR register
-    uint8_t en_rxaddr = r_register_byte(EN_RXADDR);
+    // shadow value of EN_RXADDR register
+    uint8_t en_rxaddr = driver->shadow[EN_RXADDR];
 
     // enable data pipe in EN_RXADDR register, if necessary
-    if ((en_rxaddr >> data_pipe & SET_BIT) != SET_BIT)
+    if ((status == SPI_MNGR_OK) && ((en_rxaddr >> data_pipe & SET_BIT) != SET_BIT))
     {
-      en_rxaddr |= SET_BIT << data_pipe;
-      status = w_register(EN_RXADDR, &en_rxaddr, ONE_BYTE);
+      status = w_shadow_register(driver, EN_RXADDR, en_rxaddr | (SET_BIT << data_pipe));
     }
   }
 
-  spi_manager_deinit_spi(spi->instance);
-
   return status;
 }
 
@@ -421,24 +732,20 @@ fn_status_t nrf_driver_rx_destination(data_pipe_t data_pipe, const uint8_t *buff
  * 
  * DATA_PIPE_0...DATA_PIPE_5, ALL_DATA_PIPES (6)
  * 
+ * @param driver nrf_driver_t instance
  * @param data_pipe DATA_PIPE_0...DATA_PIPE_5 or ALL_DATA_PIPES
  * @param size bytes in payload
  * 
  * @return SPI_MNGR_OK (2), ERROR (0)
  */
-fn_status_t nrf_driver_payload_size(data_pipe_t data_pipe, size_t size) {
-
-  spi_manager_t *spi = &(nrf_driver.user_spi);
-
-  // initialise SPI for function duration
-  spi_manager_init_spi(spi->instance, spi->baudrate); 
+fn_status_t nrf_driver_payload_size(nrf_driver_t *driver, data_pipe_t data_pipe, size_t size) {
 
   fn_status_t status = ((size > ZERO_BYTES) && (size <= MAX_BYTES)) ? NRF_MNGR_OK : ERROR;
 
   if (status == NRF_MNGR_OK)
   {
     // cache payload_width value
-    // nrf_driver.payload_width = size;
+    // driver->payload_width = size;
 
     register_map_t rx_pw_registers[6] = { 
       RX_PW_P0, RX_PW_P1, RX_PW_P2, 
@@ -449,19 +756,16 @@ fn_status_t nrf_driver_payload_size(data_pipe_t data_pipe, size_t size) {
     {
       for (size_t i = 0; i < ALL_DATA_PIPES; i++)
       {
-        status = w_register(rx_pw_registers[i], &size, ONE_BYTE);
+        status = w_shadow_register(driver, rx_pw_registers[i], (uint8_t)size);
         if (!status) { break; }
       }
     } 
     else 
     {
-      status = w_register(rx_pw_registers[data_pipe], &size, ONE_BYTE);
+      status = w_shadow_register(driver, rx_pw_registers[data_pipe], (uint8_t)size);
     }
   }
 
-  // deinitialise SPI at function end
-  spi_manager_deinit_spi(spi->instance); 
-
   return status;
 }
 
@@ -469,100 +773,176 @@ fn_status_t nrf_driver_payload_size(data_pipe_t data_pipe, size_t size) {
 /**
  * Enables dynamic payloads, if not already disabled.
  * 
+ * @param driver nrf_driver_t instance
+ * 
  * @return SPI_MNGR_OK (2), ERROR (0)
  */
-fn_status_t nrf_driver_dyn_payloads_enable(void) {
+fn_status_t nrf_driver_dyn_payloads_enable(nrf_driver_t *driver) {
 
-  spi_manager_t *spi = &(nrf_driver.user_spi);
-
-  spi_manager_init_spi(spi->instance, spi->baudrate);
-  
-  nrf_manager_t *config = &(nrf_driver.user_config);
+  nrf_manager_t *config = &(driver->user_config);
 
   fn_status_t status = SPI_MNGR_OK;
 
   if (config->dyn_payloads == DYNPD_DISABLE)
   {
-    uint8_t feature = r_register_byte(FEATURE);
+    uint8_t feature = driver->shadow[FEATURE] | (SET_BIT << FEATURE_EN_DPL);
 
-    feature |= SET_BIT << FEATURE_EN_DPL;
-
-    status = w_register(FEATURE, &feature, ONE_BYTE);
+    status = w_shadow_register(driver, FEATURE, feature);
 
     config->dyn_payloads = (status) ? DYNPD_ENABLE : DYNPD_DISABLE;
 
     if (status == SPI_MNGR_OK)
     {
-      status = w_register(DYNPD, (uint8_t[]){DYNPD_ENABLE}, ONE_BYTE);
+      status = w_shadow_register(driver, DYNPD, DYNPD_ENABLE);
     }
   }
 
-  spi_manager_deinit_spi(spi->instance);
-
   return status;
 }
 
 
 /**
- * Disables dynamic payloads, if not already disabled.
+ * Disables dynamic payloads, if not already disabled. ACK
+ * payloads, which require dynamic payloads, are disabled too.
+ * 
+ * @param driver nrf_driver_t instance
  * 
  * @return SPI_MNGR_OK (2), NRF_MNGR_OK (3), ERROR (0)
  */
-fn_status_t nrf_driver_dyn_payloads_disable(void) {
-
-  spi_manager_t *spi = &(nrf_driver.user_spi);
+fn_status_t nrf_driver_dyn_payloads_disable(nrf_driver_t *driver) {
 
-  // initialise SPI for function duration
-  spi_manager_init_spi(spi->instance, spi->baudrate);
-  
-  nrf_manager_t *config = &(nrf_driver.user_config);
+  nrf_manager_t *config = &(driver->user_config);
 
   fn_status_t status = NRF_MNGR_OK;
 
   if (config->dyn_payloads == DYNPD_ENABLE)
   {
-    uint8_t feature = r_register_byte(FEATURE);
-
-    // clear EN_DPL (bit 2) in FEATURE register
-    feature &= ~(SET_BIT << FEATURE_EN_DPL);
+    // clear EN_DPL (bit 2) in FEATURE register, and EN_ACK_PAY (bit 1), which requires it
+    uint8_t feature = driver->shadow[FEATURE] & ~((SET_BIT << FEATURE_EN_DPL) | (SET_BIT << FEATURE_EN_ACK_PAY));
 
-    status = w_register(FEATURE, &feature, ONE_BYTE);
+    status = w_shadow_register(driver, FEATURE, feature);
 
     config->dyn_payloads = (status) ? DYNPD_DISABLE : DYNPD_ENABLE;
 
     if (status == SPI_MNGR_OK)
     {
-      status = w_register(DYNPD, (uint8_t[]){DYNPD_DISABLE}, ONE_BYTE);
+      status = w_shadow_register(driver, DYNPD, DYNPD_DISABLE);
     }
   }
 
-  // deinitialise SPI at function end
-  spi_manager_deinit_spi(spi->instance);
+  return status;
+}
+
+/**
+ * Enables ACK payloads, by setting EN_ACK_PAY in the FEATURE 
+ * register, enabling dynamic payloads first, as ACK payloads 
+ * require them. A PRX then returns a payload queued through 
+ * nrf_driver_ack_payload with the auto-acknowledgement of a 
+ * packet received on that data pipe and the PTX reads it from
+ * its RX FIFO, as a received packet on DATA_PIPE_0.
+ * 
+ * @note ACK payloads must be enabled on the PTX and the PRX.
+ * 
+ * @param driver nrf_driver_t instance
+ * 
+ * @return SPI_MNGR_OK (2), NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_ack_payloads_enable(nrf_driver_t *driver) {
+
+  fn_status_t status = nrf_driver_dyn_payloads_enable(driver);
+
+  if (status && !((driver->shadow[FEATURE] >> FEATURE_EN_ACK_PAY) & SET_BIT))
+  {
+    uint8_t feature = driver->shadow[FEATURE] | (SET_BIT << FEATURE_EN_ACK_PAY);
+
+    status = w_shadow_register(driver, FEATURE, feature);
+  }
+
+  return status;
+}
+
+
+/**
+ * Disables ACK payloads, if not already disabled. Dynamic 
+ * payloads are left enabled.
+ * 
+ * @param driver nrf_driver_t instance
+ * 
+ * @return SPI_MNGR_OK (2), NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_ack_payloads_disable(nrf_driver_t *driver) {
+
+  fn_status_t status = NRF_MNGR_OK;
+
+  if ((driver->shadow[FEATURE] >> FEATURE_EN_ACK_PAY) & SET_BIT)
+  {
+    // clear EN_ACK_PAY (bit 1) in FEATURE register
+    uint8_t feature = driver->shadow[FEATURE] & ~(SET_BIT << FEATURE_EN_ACK_PAY);
+
+    status = w_shadow_register(driver, FEATURE, feature);
+  }
+
+  return status;
+}
+
+
+/**
+ * Queues a payload in the TX FIFO of a PRX, through the 
+ * W_ACK_PAYLOAD command, which is returned with the next 
+ * auto-acknowledgement on the data pipe, without switching
+ * out of RX Mode. Up to three ACK payloads can be queued.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param data_pipe DATA_PIPE_0 - DATA_PIPE_5
+ * @param payload ACK payload
+ * @param size size of payload
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0) if ACK payloads are disabled or the TX FIFO is full
+ */
+fn_status_t nrf_driver_ack_payload(nrf_driver_t *driver, data_pipe_t data_pipe, const void *payload, size_t size) {
+
+  bool is_ack_pay = (driver->shadow[FEATURE] >> FEATURE_EN_ACK_PAY) & SET_BIT;
+
+  fn_status_t status = (is_ack_pay && (data_pipe < ALL_DATA_PIPES) && (size > ZERO_BYTES) && (size <= MAX_BYTES)) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    // STATUS register value, clocked in with the command
+    uint8_t status_reg = 0;
+
+    // W_ACK_PAYLOAD command for the data pipe (0b10101PPP), followed by payload streamed without a copy
+    status = (spi_write_command(driver, W_ACK_PAYLOAD_P0 | data_pipe, payload, size, &status_reg) == SPI_MNGR_OK) ? NRF_MNGR_OK : ERROR;
+
+    // a payload written whilst TX_FULL was set is discarded by the NRF24L01
+    if ((status_reg >> STATUS_TX_FULL) & SET_BIT) { status = ERROR; }
+  }
 
   return status;
 }
 
+
 /**
  * Set the RF channel. Each device must be on the same 
  * channel in order to communicate.
  * 
+ * @param driver nrf_driver_t instance
  * @param channel RF channel 1..125
  * 
  * @return SPI_MNGR_OK (2), ERROR (0)
  */
-fn_status_t nrf_driver_rf_channel(uint8_t channel) {
+fn_status_t nrf_driver_rf_channel(nrf_driver_t *driver, uint8_t channel) {
 
   fn_status_t status = ((channel >= 2) && (channel <= 125)) ? NRF_MNGR_OK : ERROR;
 
   if (status == NRF_MNGR_OK)
   {
     // write channel number to RF_CH register
-    status = w_register(RF_CH, &channel, ONE_BYTE);
+    status = w_shadow_register(driver, RF_CH, channel);
 
-    // allows less verbose access to nrf_driver.user_config.channel
-    nrf_manager_t *user_config = &(nrf_driver.user_config);
+    // allows less verbose access to driver->user_config.channel
+    nrf_manager_t *user_config = &(driver->user_config);
 
-    // store channel configuration in global nrf_driver_t
+    // store channel configuration in driver struct
     user_config->channel = (status == SPI_MNGR_OK) ? channel : user_config->channel;
   }
   
@@ -584,16 +964,13 @@ fn_status_t nrf_driver_rf_channel(uint8_t channel) {
  * specified ARD. After the ARD, it goes to TX mode and retransmits 
  * the packet.
  * 
+ * @param driver nrf_driver_t instance
  * @param delay ARD_250US, ARD_500US, ARD_750US, ARD_1000US
  * @param count ARC_NONE, ARC_1RT...ARC_15RT
  * 
  * @return SPI_MNGR_OK (2), ERROR (0)
  */
-fn_status_t nrf_driver_auto_retransmission(retr_delay_t delay, retr_count_t count) {
-
-  spi_manager_t *spi = &(nrf_driver.user_spi);
-
-  spi_manager_init_spi(spi->instance, spi->baudrate); // initialise SPI for function duration
+fn_status_t nrf_driver_auto_retransmission(nrf_driver_t *driver, retr_delay_t delay, retr_count_t count) {
 
   uint8_t valid_params = 0;
 
@@ -614,10 +991,14 @@ fn_status_t nrf_driver_auto_retransmission(retr_delay_t delay, retr_count_t coun
   if (status == NRF_MNGR_OK)
   {
     // write specified ARD and ARC settings to SETUP_RETR register
-    status  = w_register(SETUP_RETR, (uint8_t*)(delay | count), ONE_BYTE);
-  }
+    status = w_shadow_register(driver, SETUP_RETR, delay | count);
 
-  spi_manager_deinit_spi(spi->instance); // deinitialise SPI at function end
+    if (status == SPI_MNGR_OK)
+    {
+      driver->user_config.retr_delay = delay;
+      driver->user_config.retr_count = count;
+    }
+  }
 
   return status;
 }
@@ -627,16 +1008,12 @@ fn_status_t nrf_driver_auto_retransmission(retr_delay_t delay, retr_count_t coun
  * Set the RF data rates in the RF_SETUP register
  * through the RF_DR_LOW and RF_DR_HIGH bits.
  * 
+ * @param driver nrf_driver_t instance
  * @param data_rate RF_DR_1MBPS, RF_DR_2MBPS, RF_DR_250KBPS
  * 
  * @return SPI_MNGR_OK (2), ERROR (0)
  */
-fn_status_t nrf_driver_rf_data_rate(rf_data_rate_t data_rate) {
-
-  spi_manager_t *spi = &(nrf_driver.user_spi);
-
-  // initialise SPI for function duration
-  spi_manager_init_spi(spi->instance, spi->baudrate);
+fn_status_t nrf_driver_rf_data_rate(nrf_driver_t *driver, rf_data_rate_t data_rate) {
 
   fn_status_t status = NRF_MNGR_OK;
 
@@ -659,15 +1036,12 @@ fn_status_t nrf_driver_rf_data_rate(rf_data_rate_t data_rate) {
 
   if (status == NRF_MNGR_OK)
   {
-    // Value of RF_SETUP register
-    uint8_t rf_setup = r_register_byte(RF_SETUP);
-
-    rf_setup = (rf_setup & RF_SETUP_RF_PWR_MASK) | (data_rate & RF_SETUP_RF_DR_MASK);
+    // shadow value of RF_SETUP register
+    uint8_t rf_setup = (driver->shadow[RF_SETUP] & RF_SETUP_RF_PWR_MASK) | (data_rate & RF_SETUP_RF_DR_MASK);
 
-    status = w_register(RF_SETUP, &rf_setup, ONE_BYTE);
+    status = w_shadow_register(driver, RF_SETUP, rf_setup);
 
-    // deinitialise SPI at function end
-    spi_manager_deinit_spi(spi->instance); 
+    if (status == SPI_MNGR_OK) { driver->user_config.data_rate = data_rate; }
   }
 
   return status;
@@ -678,47 +1052,40 @@ fn_status_t nrf_driver_rf_data_rate(rf_data_rate_t data_rate) {
  * Set TX Mode power level in RF_SETUP register through
  * the RF_PWR bits.
  * 
+ * @param driver nrf_driver_t instance
  * @param rf_pwr RF_PWR_NEG_18DBM, RF_PWR_NEG_12DBM, RF_PWR_NEG_6DBM, RF_PWR_0DBM
  * 
  * @return SPI_MNGR_OK (2), ERROR (0)
  */
-fn_status_t nrf_driver_rf_power(rf_power_t rf_pwr) {
-
-  spi_manager_t *spi = &(nrf_driver.user_spi);
-
-  // initialise SPI for function duration
-  spi_manager_init_spi(spi->instance, spi->baudrate);
+fn_status_t nrf_driver_rf_power(nrf_driver_t *driver, rf_power_t rf_pwr) {
 
   fn_status_t status = ERROR;
 
   // validate RF power setting
-  for (size_t i = 0; i < 6; i += 2)
+  for (size_t i = 0; i <= RF_PWR_0DBM; i += 2)
   {
     if (rf_pwr == i) { status = NRF_MNGR_OK; break; }
   }
 
   if (status == NRF_MNGR_OK)
   {
-    // Read RF_SETUP register value
-    uint8_t rf_setup = r_register_byte(RF_SETUP);
+    // shadow value of RF_SETUP register
+    uint8_t rf_setup = (driver->shadow[RF_SETUP] & RF_SETUP_RF_DR_MASK) | (rf_pwr & RF_SETUP_RF_PWR_MASK);
 
-    rf_setup = (rf_setup & RF_SETUP_RF_DR_MASK) | (rf_pwr & RF_SETUP_RF_PWR_MASK);
+    status = w_shadow_register(driver, RF_SETUP, rf_setup);
 
-    // holds OK (0) or REGISTER_W_FAIL (3)
-    status = w_register(RF_SETUP, &rf_setup, ONE_BYTE);
+    if (status == SPI_MNGR_OK) { driver->user_config.power = rf_pwr; }
   }
 
-  // deinitialise SPI at function end
-  spi_manager_deinit_spi(spi->instance); 
-
   return status;
 }
 
 
 /**
- * Puts the NRF24L01 into Standby-I Mode. Resets the CONFIG 
- * register PRIM_RX bit value, in preparation for entering
- * TX Mode and drives CE pin LOW.
+ * Puts the NRF24L01 into Standby-I Mode. Drives CE pin LOW and
+ * resets the CONFIG register PRIM_RX bit value, in preparation 
+ * for entering TX Mode. Standby-I Mode is entered as soon as CE
+ * is LOW, so there is no settling time to wait for.
  * 
  * NOTE: State diagram in the datasheet (6.1.1) highlights
  * conditions for entering RX and TX operating modes. One 
@@ -727,669 +1094,3102 @@ fn_status_t nrf_driver_rf_power(rf_power_t rf_pwr) {
  * pin is driven HIGH for Rx mode and is only driven high 
  * in TX Mode to facilitate the Tx of data (10us+).
  * 
+ * @param driver nrf_driver_t instance
+ * 
  * @return SPI_MNGR_OK (2), ERROR (0)
  */
-fn_status_t nrf_driver_standby_mode(void) {
+fn_status_t nrf_driver_standby_mode(nrf_driver_t *driver) {
 
-  // initialise SPI at function start
-  spi_manager_t *spi = &(nrf_driver.user_spi);
+  // the duty cycle switches modes, until nrf_driver_duty_cycle_stop
+  fn_status_t status = (!driver->is_duty_cycle) ? NRF_MNGR_OK : ERROR;
 
-  spi_manager_init_spi(spi->instance, spi->baudrate);
-
-  fn_status_t status = NRF_MNGR_OK;
-
-  if (nrf_driver.mode == RX_MODE)
+  if ((status == NRF_MNGR_OK) && (driver->mode == RX_MODE))
   {
-    // read CONFIG register value
-    uint8_t config = r_register_byte(CONFIG);
-
-    config &= ~(SET_BIT << CONFIG_PRIM_RX);
+    // Drive CE LOW, NRF24L01+ enters Standby-I mode without a settling time
+    ce_put_low(driver->user_pins.ce);
 
-    w_register(CONFIG, &config, ONE_BYTE);
+    cancel_rx_settle(driver);
 
-    // Drive CE LOW
-    ce_put_low(nrf_driver.user_pins.ce);
+    // clear PRIM_RX bit in shadow value of CONFIG register, whilst CE is LOW
+    uint8_t config = driver->shadow[CONFIG] & ~(SET_BIT << CONFIG_PRIM_RX);
 
-    // NRF24L01+ enters Standby-I mode after 130μS
-    sleep_us(130);
+    status = (w_shadow_register(driver, CONFIG, config) == SPI_MNGR_OK) ? NRF_MNGR_OK : ERROR;
 
-    nrf_driver.mode = STANDBY_I;
+    driver->mode = STANDBY_I;
   }
 
-  // deinitialise SPI at function end
-  spi_manager_deinit_spi(spi->instance);
-
   return status;
 }
 
 
 /**
  * Transmits a payload to a recipient NRF24L01 and will return 
- * SPI_MNGR_OK (2) if the transmission was successful and an 
+ * NRF_MNGR_OK (3) if the transmission was successful and an 
  * auto-acknowledgement was received from the recipient NRF24L01. 
  * A return value of ERROR (0) indicates that either, the packet 
  * transmission failed, or no auto-acknowledgement was received 
  * before max retransmissions count was reached.
  * 
+ * @note The outcome is waited for up to TX_TIMEOUT_US, after which
+ * the TX FIFO is flushed and ERROR (0) is returned, so an NRF24L01
+ * which stops responding does not block the caller.
+ * 
+ * @param driver nrf_driver_t instance
  * @param tx_packet packet for transmission
  * @param size size of tx_packet
  * 
- * @return SPI_MNGR_OK (2), ERROR (0)
+ * @return NRF_MNGR_OK (3), ERROR (0)
  */
-fn_status_t nrf_driver_send_packet(const void *tx_packet, size_t size) {
+fn_status_t nrf_driver_send_packet(nrf_driver_t *driver, const void *tx_packet, size_t size) {
 
-  if (nrf_driver.mode == RX_MODE) { 
-    nrf_driver_standby_mode(); 
-    nrf_driver.mode = STANDBY_I;
-  }
-
-  spi_manager_t *spi = &(nrf_driver.user_spi);
+  fn_status_t status = nrf_driver_send_packet_async(driver, tx_packet, size);
 
-  spi_manager_init_spi(spi->instance, spi->baudrate);
-  
-  // fn_status_t status = (size <= nrf_driver.payload_width) ? NRF_MNGR_OK : ERROR;
+  // NONE_ASSERTED (0), TX_DS_ASSERTED (2), MAX_RT_ASSERTED (3)
+  fn_status_irq_t status_irq = NONE_ASSERTED;
 
-  // cast void *tx_packet to uint8_t pointer
-  const uint8_t *tx_packet_ptr = (uint8_t *)tx_packet;
+  // time after which the packet is abandoned
+  absolute_time_t deadline = make_timeout_time_us(TX_TIMEOUT_US);
 
-  // W_TX_PAYLOAD command + packet_size
-  size_t total_size = size + 1;
+  bool is_timeout = false;
 
-  uint8_t tx_buffer[total_size]; // SPI transfer TX buffer
-  uint8_t rx_buffer[total_size]; // SPI transfer RX buffer
+  /**
+   * if the packet was uploaded, then poll STATUS register, checking TX_DS 
+   * (auto-acknowledgement received) and MAX_RT (max retransmissions) bits 
+   * in the STATUS register. If neither bits are set (NONE_ASSERTED), keep 
+   * polling, until TX_TIMEOUT_US. With an IRQ pin, the core sleeps until 
+   * the IRQ pin interrupt or the deadline, between polls.
+   */
+  while ((status == NRF_MNGR_OK) && (status_irq == NONE_ASSERTED) && !is_timeout)
+  {
+    status_irq = complete_tx(driver, NULL);
 
-  // put W_TX_PAYLOAD command into first index of tx_buffer
-  tx_buffer[0] = W_TX_PAYLOAD;
+    if ((status_irq == NONE_ASSERTED) && (driver->irq_pin != IRQ_PIN_UNUSED) && !driver->is_irq_pending) { best_effort_wfe_or_timeout(deadline); }
 
-  // store byte(s) in tx_packet (tx_packet_ptr) into tx_buffer[]
-  for (size_t i = 1; i < total_size; i++)
-  { 
-    tx_buffer[i] = tx_packet_ptr[i - 1]; 
+    is_timeout = time_reached(deadline);
   }
 
-  ce_put_high(nrf_driver.user_pins.ce);
-
-  csn_put_low(nrf_driver.user_pins.csn); // drive CSN pin LOW
-  fn_status_t status = spi_manager_transfer(spi->instance, tx_buffer, rx_buffer, total_size);
-  csn_put_high(nrf_driver.user_pins.csn); // drive CSN pin HIGH
-
-  nrf_driver.mode = TX_MODE;
-
-  // pulse CE high for 10us to transmit
-  sleep_us(15); 
-
-  ce_put_low(nrf_driver.user_pins.ce);
+  if ((status == NRF_MNGR_OK) && (status_irq == NONE_ASSERTED))
+  {
+    // the packet is flushed from the TX FIFO, so a later packet is not sent behind it
+    spi_manager_frame_t frame = { .tx_buffer = (uint8_t[]){ FLUSH_TX }, .rx_buffer = NULL, .len = ONE_BYTE };
 
-  nrf_driver.mode = STANDBY_I;
+    spi_transfer_batch(driver, &frame, 1);
 
-  fn_status_irq_t status_irq = check_status_irq(NULL);
+    driver->is_tx_pending = false;
+  }
 
   /**
-   * if spi_manager_transfer returns SPI_MNGR_OK, then poll STATUS register, checking 
-   * TX_DS (auto-acknowledgement received) and MAX_RT (max retransmissions) bits in 
-   * the STATUS register. If neither bits are set (NONE_ASSERTED), keep polling.
+   * returns NRF_MNGR_OK (3) if the packet was uploaded and TX_DS was asserted. 
+   * Else ERROR (0), which indicates either an error in the SPI transfer of the 
+   * packet or that auto-acknowledgment was not received after the packet was 
+   * retransmitted the max number of times, indicated by the STATUS register 
+   * MAX_RT bit being asserted (1).
    */
-  while ((status == SPI_MNGR_OK) && (status_irq == NONE_ASSERTED))
-  {
-     status_irq = check_status_irq(NULL);
-  }
-  
-  spi_manager_deinit_spi(spi->instance);
-
   status = (status_irq == TX_DS_ASSERTED) ? NRF_MNGR_OK : ERROR;
 
-  /**
-   * returns NRF_MNGR_OK (3) if spi_manager_transfer returned SPI_MNGR_OK (2) and 
-   * check_status_irq returned TX_DS_ASSERTED (2). Else ERROR (0), which indicates 
-   * either an error in the SPI transfer of the packet or that auto-acknowledgment 
-   * was not received after the packet was retransmitted the max number of times, 
-   * indicated by the STATUS register MAX_RT bit being asserted (1).
-   */
   return status;
 }
 
 
 /**
- * Read an available packet from the RX FIFO into the 
- * buffer (rx_packet).
+ * Uploads a payload to the TX FIFO and pulses CE to transmit it, 
+ * returning without waiting for an auto-acknowledgement. The 
+ * outcome is available through nrf_driver_poll_tx, which calls 
+ * the nrf_driver_tx_callback callback, if set. Only one packet 
+ * may be in flight at a time.
  * 
- * @param rx_packet packet buffer for receipt
- * @param size size of buffer
+ * @param driver nrf_driver_t instance
+ * @param tx_packet packet for transmission
+ * @param size size of tx_packet
  * 
- * @return SPI_MNGR_OK (2), ERROR (0)
+ * @return NRF_MNGR_OK (3), ERROR (0)
  */
-fn_status_t nrf_driver_read_packet(void *rx_packet, size_t size) {
+fn_status_t nrf_driver_send_packet_async(nrf_driver_t *driver, const void *tx_packet, size_t size) {
 
-  spi_manager_t *spi = &(nrf_driver.user_spi);
+  // a previous packet, a packet in the TX queue or a beacon, is still awaiting its outcome
+  fn_status_t status = (is_tx_idle(driver)) ? NRF_MNGR_OK : ERROR;
 
-  // initialise SPI at function start
-  spi_manager_init_spi(spi->instance, spi->baudrate);
+  if (status == NRF_MNGR_OK)
+  {
+    if (driver->mode == RX_MODE) { nrf_driver_standby_mode(driver); }
 
-  fn_status_t status = SPI_MNGR_OK;
+    // TX_DS or MAX_RT held from before this packet is not its outcome
+    consume_events(driver, TX_DS_EVENT | MAX_RT_EVENT);
 
-  /**
-   * if dynamic payloads are enabled, read the payload width
-   * via the R_RX_PL_WID command and check it is not greater
-   * than 32 (max payload size). If it is, the packet is 
-   * corrupted and RX FIFO is flushed. 
-   */
-  if (nrf_driver.user_config.dyn_payloads)
-  {
-    uint8_t tx_buffer[2] = { R_RX_PL_WID, NOP };
-    uint8_t rx_buffer[2];
+    // W_TX_PAYLOAD command, followed by tx_packet streamed without a copy
+    status = (spi_write_command(driver, W_TX_PAYLOAD, tx_packet, size, NULL) == SPI_MNGR_OK) ? NRF_MNGR_OK : ERROR;
 
-    csn_put_low(nrf_driver.user_pins.csn); // drive CSN pin LOW
-    status = spi_manager_transfer(spi->instance, tx_buffer, rx_buffer, TWO_BYTES);
-    csn_put_high(nrf_driver.user_pins.csn); // drive CSN pin HIGH
+    // pulse CE high to transmit, ended by an alarm
+    if (status == NRF_MNGR_OK) { pulse_ce(driver); }
 
-    // rx_buffer[0] holds STatus REGISTER value
-    if (rx_buffer[1] > MAX_BYTES) 
-    {
-      flush_rx_fifo();
-      status = ERROR;
-    }
+    driver->mode = STANDBY_I;
+
+    driver->is_tx_pending = (status == NRF_MNGR_OK);
   }
 
-  if (status)
+  return status;
+}
+
+
+/**
+ * Indicates if a packet sent by nrf_driver_send_packet_async 
+ * has completed. Once completed, the outcome is passed to 
+ * tx_status (if not NULL) and the nrf_driver_tx_callback 
+ * callback (if set). With an IRQ pin, the STATUS register is 
+ * only read once the NRF24L01 has signalled an interrupt.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param tx_status outcome of the packet or NULL
+ * 
+ * @return NRF_MNGR_OK (3) if completed, ERROR (0) if in flight or no packet was sent
+ */
+fn_status_t nrf_driver_poll_tx(nrf_driver_t *driver, tx_status_t *tx_status) {
+
+  tx_status_t outcome;
+
+  fn_status_t status = (complete_tx(driver, &outcome) != NONE_ASSERTED) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    if (tx_status != NULL) { *tx_status = outcome; }
+
+    if (driver->tx_callback != NULL) { driver->tx_callback(&outcome, driver->tx_user_data); }
+  }
+
+  return status;
+}
+
+
+/**
+ * Sets a callback, called by nrf_driver_poll_tx with the 
+ * outcome of a packet sent by nrf_driver_send_packet_async.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param callback completion callback or NULL
+ * @param user_data passed to callback
+ * 
+ * @return NRF_MNGR_OK (3)
+ */
+fn_status_t nrf_driver_tx_callback(nrf_driver_t *driver, tx_callback_t callback, void *user_data) {
+
+  driver->tx_callback = callback;
+  driver->tx_user_data = user_data;
+
+  return NRF_MNGR_OK;
+}
+
+
+/**
+ * Transmits count payloads of size bytes, held back to back in 
+ * tx_packets, holding CE HIGH (Standby-II and TX Mode) whilst 
+ * up to three payloads are kept queued in the TX FIFO. The TX 
+ * FIFO is topped up as TX_DS flags free slots, so the NRF24L01 
+ * transmits the next payload without waiting for an SPI upload.
+ * 
+ * A payload reaching MAX_RT is flushed from the TX FIFO, with 
+ * the payloads queued behind it, which are then uploaded again. 
+ * The outcome of each payload (TX_DS_ASSERTED, MAX_RT_ASSERTED) 
+ * is stored in outcomes (if not NULL), in payload order.
+ * 
+ * @note Outcomes are counted from the occupancy of the TX FIFO
+ * (see complete_tx_fifo), as TX_DS is asserted once for any number
+ * of payloads completed before it is reset. If no payload completes
+ * within TX_TIMEOUT_US, the TX FIFO is flushed and the remaining 
+ * payloads are reported as MAX_RT_ASSERTED.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param tx_packets payloads for transmission
+ * @param size size of each payload
+ * @param count number of payloads
+ * @param outcomes outcome of each payload or NULL
+ * 
+ * @return NRF_MNGR_OK (3) if every payload was acknowledged, ERROR (0)
+ */
+fn_status_t nrf_driver_send_stream(nrf_driver_t *driver, const void *tx_packets, size_t size, size_t count, fn_status_irq_t *outcomes) {
+
+  const uint8_t *packets = (const uint8_t *)tx_packets;
+
+  // a packet sent by send_packet_async, a packet in the TX queue or a beacon, is still awaiting its outcome
+  fn_status_t status = ((size > ZERO_BYTES) && (size <= MAX_BYTES) && is_tx_idle(driver)) ? NRF_MNGR_OK : ERROR;
+
+  // payloads uploaded to the TX FIFO, completed and acknowledged
+  size_t uploaded = 0;
+  size_t completed = 0;
+  size_t acknowledged = 0;
+
+  // time after which the stream is abandoned, unless a payload completes
+  absolute_time_t deadline = make_timeout_time_us(TX_TIMEOUT_US);
+
+  if (status == NRF_MNGR_OK)
+  {
+    if (driver->mode == RX_MODE) { nrf_driver_standby_mode(driver); }
+
+    // TX_DS or MAX_RT held from before the stream is not an outcome
+    consume_events(driver, TX_DS_EVENT | MAX_RT_EVENT);
+
+    // CE is held HIGH, so each payload is transmitted once uploaded
+    cancel_ce_pulse(driver);
+    ce_put_high(driver->user_pins.ce);
+
+    driver->mode = STANDBY_II;
+  }
+
+  while ((status == NRF_MNGR_OK) && (completed < count))
+  {
+    // STATUS register value, clocked in before each payload
+    uint8_t upload_status = 0;
+
+    // top up the TX FIFO, up to three payloads, until TX_FULL
+    while ((status == NRF_MNGR_OK) && (uploaded < count) && ((uploaded - completed) < 3))
+    {
+      status = (spi_write_command(driver, W_TX_PAYLOAD, &packets[uploaded * size], size, &upload_status) == SPI_MNGR_OK) ? NRF_MNGR_OK : ERROR;
+
+      // a payload written whilst TX_FULL was set is discarded by the NRF24L01
+      if ((upload_status >> STATUS_TX_FULL) & SET_BIT) { break; }
+
+      uploaded++;
+    }
+
+    driver->mode = TX_MODE;
+
+    // with an IRQ pin, the core sleeps until TX_DS, MAX_RT or the deadline
+    while ((status == NRF_MNGR_OK) && (driver->irq_pin != IRQ_PIN_UNUSED) && !driver->is_irq_pending && !(driver->status_reg & STATUS_INTERRUPT_MASK))
+    {
+      if (best_effort_wfe_or_timeout(deadline)) { break; }
+    }
+
+    driver->is_irq_pending = false;
+
+    // outcomes of the payloads completed, oldest first, counted from the TX FIFO occupancy
+    fn_status_irq_t fifo_outcomes[3];
+
+    size_t done = complete_tx_fifo(driver, uploaded - completed, fifo_outcomes);
+
+    for (size_t i = 0; i < done; i++, completed++)
+    {
+      if (outcomes != NULL) { outcomes[completed] = fifo_outcomes[i]; }
+
+      if (fifo_outcomes[i] == TX_DS_ASSERTED) { acknowledged++; }
+    }
+
+    if ((done > 0) && (fifo_outcomes[done - 1] == MAX_RT_ASSERTED))
+    {
+      // upload the payloads flushed behind the one which reached MAX_RT again
+      uploaded = completed;
+
+      // CE was driven LOW by complete_tx_fifo
+      ce_put_high(driver->user_pins.ce);
+    }
+
+    if (done > 0) { deadline = make_timeout_time_us(TX_TIMEOUT_US); }
+    else if ((status == NRF_MNGR_OK) && time_reached(deadline)) { status = ERROR; }
+
+    // a flag asserted after STATUS was read holds the IRQ pin LOW
+    if ((driver->irq_pin != IRQ_PIN_UNUSED) && irq_is_low(driver->irq_pin)) { driver->is_irq_pending = true; }
+  }
+
+  if ((status != NRF_MNGR_OK) && (uploaded > completed))
+  {
+    // payloads left in the TX FIFO are not sent behind a later packet
+    spi_manager_frame_t frame = { .tx_buffer = (uint8_t[]){ FLUSH_TX }, .rx_buffer = NULL, .len = ONE_BYTE };
+
+    spi_transfer_batch(driver, &frame, 1);
+  }
+
+  if ((status != NRF_MNGR_OK) && (outcomes != NULL))
+  {
+    // payloads not completed, after a timeout or an SPI transfer error, failed
+    for (; completed < count; completed++) { outcomes[completed] = MAX_RT_ASSERTED; }
+  }
+
+  if (driver->mode != STANDBY_I)
+  {
+    // Drive CE LOW, NRF24L01+ enters Standby-I mode
+    ce_put_low(driver->user_pins.ce);
+
+    driver->mode = STANDBY_I;
+  }
+
+  status = ((status == NRF_MNGR_OK) && (acknowledged == count)) ? NRF_MNGR_OK : ERROR;
+
+  return status;
+}
+
+
+/**
+ * Uploads a payload to the TX FIFO through the W_TX_PAYLOAD_NOACK
+ * command and pulses CE to transmit it, returning without waiting.
+ * The receiver does not acknowledge the packet and it is never 
+ * retransmitted, so delivery is not known. TX_DS, asserted once a
+ * previous packet was transmitted, is reset.
+ * 
+ * @note Returns ERROR, without transmitting, if the TX FIFO is full, 
+ * as three packets await transmission.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param tx_packet packet for transmission
+ * @param size size of tx_packet
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_send_packet_noack(nrf_driver_t *driver, const void *tx_packet, size_t size) {
+
+  // W_TX_PAYLOAD_NOACK command is enabled by EN_DYN_ACK in the FEATURE register
+  bool is_dyn_ack = (driver->shadow[FEATURE] >> FEATURE_EN_DYN_ACK) & SET_BIT;
+
+  fn_status_t status = (is_dyn_ack && is_tx_idle(driver) && (size > ZERO_BYTES) && (size <= MAX_BYTES)) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    if (driver->mode == RX_MODE) { nrf_driver_standby_mode(driver); }
+
+    // STATUS register value, clocked in with the command
+    uint8_t status_reg = 0;
+
+    status = (spi_write_command(driver, W_TX_PAYLOAD_NOACK, tx_packet, size, &status_reg) == SPI_MNGR_OK) ? NRF_MNGR_OK : ERROR;
+
+    // a payload written whilst TX_FULL was set is discarded by the NRF24L01
+    if ((status_reg >> STATUS_TX_FULL) & SET_BIT) { status = ERROR; }
+
+    // pulse CE high to transmit, ended by an alarm
+    if (status == NRF_MNGR_OK) { pulse_ce(driver); }
+
+    // reset TX_DS (bit 5) of a previous packet, so it does not hold the IRQ pin LOW
+    if ((status_reg >> STATUS_TX_DS) & SET_BIT)
+    {
+      uint8_t reset_bits = SET_BIT << STATUS_TX_DS;
+
+      w_register(driver, STATUS, &reset_bits, ONE_BYTE);
+    }
+
+    driver->mode = STANDBY_I;
+  }
+
+  return status;
+}
+
+
+/**
+ * Transmits count payloads of size bytes, held back to back in 
+ * tx_packets, through the W_TX_PAYLOAD_NOACK command, holding CE 
+ * HIGH whilst the TX FIFO is kept full. No packet is acknowledged
+ * or retransmitted, so packets are transmitted at near the air 
+ * data rate, with delivery not known. The function returns once
+ * the TX FIFO is empty.
+ * 
+ * @note If a TX FIFO slot is not freed, or the TX FIFO is not 
+ * emptied, within TX_TIMEOUT_US, CE is driven LOW, the TX FIFO is
+ * flushed and ERROR (0) is returned.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param tx_packets payloads for transmission
+ * @param size size of each payload
+ * @param count number of payloads
+ * 
+ * @return NRF_MNGR_OK (3) if every payload was transmitted, ERROR (0)
+ */
+fn_status_t nrf_driver_send_stream_noack(nrf_driver_t *driver, const void *tx_packets, size_t size, size_t count) {
+
+  const uint8_t *packets = (const uint8_t *)tx_packets;
+
+  // W_TX_PAYLOAD_NOACK command is enabled by EN_DYN_ACK in the FEATURE register
+  bool is_dyn_ack = (driver->shadow[FEATURE] >> FEATURE_EN_DYN_ACK) & SET_BIT;
+
+  fn_status_t status = (is_dyn_ack && is_tx_idle(driver) && (size > ZERO_BYTES) && (size <= MAX_BYTES)) ? NRF_MNGR_OK : ERROR;
+
+  size_t uploaded = 0;
+
+  // time after which the stream is abandoned, unless a payload is uploaded
+  absolute_time_t deadline = make_timeout_time_us(TX_TIMEOUT_US);
+
+  if (status == NRF_MNGR_OK)
+  {
+    if (driver->mode == RX_MODE) { nrf_driver_standby_mode(driver); }
+
+    // CE is held HIGH, so each payload is transmitted once uploaded
+    cancel_ce_pulse(driver);
+    ce_put_high(driver->user_pins.ce);
+
+    driver->mode = TX_MODE;
+  }
+
+  while ((status == NRF_MNGR_OK) && (uploaded < count))
+  {
+    // STATUS register value, clocked in with the command
+    uint8_t status_reg = 0;
+
+    status = (spi_write_command(driver, W_TX_PAYLOAD_NOACK, &packets[uploaded * size], size, &status_reg) == SPI_MNGR_OK) ? NRF_MNGR_OK : ERROR;
+
+    if (!((status_reg >> STATUS_TX_FULL) & SET_BIT))
+    {
+      uploaded++;
+
+      deadline = make_timeout_time_us(TX_TIMEOUT_US);
+
+    } else {
+
+      // the payload was discarded, so is uploaded again once STATUS shows a free slot
+      while (((r_status(driver) >> STATUS_TX_FULL) & SET_BIT) && (status == NRF_MNGR_OK))
+      {
+        if (time_reached(deadline)) { status = ERROR; }
+      }
+    }
+  }
+
+  // wait for the remaining payloads to be transmitted
+  while ((status == NRF_MNGR_OK) && !((r_register_byte(driver, FIFO_STATUS) >> FIFO_STATUS_TX_EMPTY) & SET_BIT))
+  {
+    if (time_reached(deadline)) { status = ERROR; }
+  }
+
+  if (driver->mode == TX_MODE)
+  {
+    // Drive CE LOW, NRF24L01+ enters Standby-I mode
+    ce_put_low(driver->user_pins.ce);
+
+    driver->mode = STANDBY_I;
+
+    if (status != NRF_MNGR_OK)
+    {
+      // payloads left in the TX FIFO are not sent behind a later packet
+      spi_manager_frame_t frame = { .tx_buffer = (uint8_t[]){ FLUSH_TX }, .rx_buffer = NULL, .len = ONE_BYTE };
+
+      spi_transfer_batch(driver, &frame, 1);
+    }
+  }
+
+  if (driver->status_reg & (SET_BIT << STATUS_TX_DS))
+  {
+    // reset TX_DS (bit 5), asserted as each payload was transmitted
+    uint8_t reset_bits = SET_BIT << STATUS_TX_DS;
+
+    w_register(driver, STATUS, &reset_bits, ONE_BYTE);
+  }
+
+  return status;
+}
+
+
+/**
+ * Uploads a beacon payload once, through the W_TX_PAYLOAD_NOACK 
+ * command, followed by the REUSE_TX_PL command, so the NRF24L01 
+ * retransmits it with each CE pulse. A repeating timer pulses CE
+ * every interval_us, from its alarm interrupt, without any SPI 
+ * transfer. The beacon is not acknowledged by receivers.
+ * 
+ * @note Other transmit functions return ERROR, until the beacon is
+ * stopped through nrf_driver_beacon_stop. 
+ * 
+ * @param driver nrf_driver_t instance
+ * @param payload beacon payload
+ * @param size size of payload
+ * @param interval_us time between transmissions (us)
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_beacon_start(nrf_driver_t *driver, const void *payload, size_t size, uint32_t interval_us) {
+
+  // W_TX_PAYLOAD_NOACK command is enabled by EN_DYN_ACK in the FEATURE register
+  bool is_dyn_ack = (driver->shadow[FEATURE] >> FEATURE_EN_DYN_ACK) & SET_BIT;
+
+  fn_status_t status = (is_dyn_ack && is_tx_idle(driver) && (interval_us >= BEACON_AIRTIME_US)) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    if (driver->mode == RX_MODE) { nrf_driver_standby_mode(driver); }
+
+    // the payload is uploaded before the first CE pulse
+    driver->is_beacon = true;
+    driver->is_beacon_update = true;
+
+    status = nrf_driver_beacon_update(driver, payload, size);
+
+    // negative delay, so transmissions are interval_us apart, start to start
+    if ((status == NRF_MNGR_OK) && !add_repeating_timer_us(-(int64_t)interval_us, beacon_callback, driver, &(driver->beacon_timer)))
+    {
+      status = ERROR;
+    }
+
+    driver->is_beacon = (status == NRF_MNGR_OK);
+    driver->is_beacon_update = false;
+  }
+
+  return status;
+}
+
+
+/**
+ * Replaces the beacon payload, between CE pulses. The CE pulse 
+ * is skipped, whilst the payload is replaced, and the update 
+ * waits for a transmission in progress to complete, as the TX 
+ * FIFO must not be written during a transmission.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param payload beacon payload
+ * @param size size of payload
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_beacon_update(nrf_driver_t *driver, const void *payload, size_t size) {
+
+  fn_status_t status = (driver->is_beacon && (size > ZERO_BYTES) && (size <= MAX_BYTES)) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    // beacon_callback skips its CE pulse, from here
+    driver->is_beacon_update = true;
+
+    wait_beacon_airtime(driver);
+
+    // FLUSH_TX ends the reuse of the previous payload and resets TX_FULL
+    spi_manager_frame_t frames[2] = {
+      { .tx_buffer = (uint8_t[]){ FLUSH_TX }, .rx_buffer = NULL, .len = ONE_BYTE },
+      { .tx_buffer = (uint8_t[]){ (REGISTER_MASK & STATUS) | W_REGISTER, SET_BIT << STATUS_TX_DS }, .rx_buffer = NULL, .len = TWO_BYTES }
+    };
+
+    status = (spi_transfer_batch(driver, frames, 2) == SPI_MNGR_OK) ? NRF_MNGR_OK : ERROR;
+
+    // W_TX_PAYLOAD_NOACK command, followed by payload streamed without a copy
+    if (status == NRF_MNGR_OK)
+    {
+      status = (spi_write_command(driver, W_TX_PAYLOAD_NOACK, payload, size, NULL) == SPI_MNGR_OK) ? NRF_MNGR_OK : ERROR;
+    }
+
+    // the payload is transmitted with each CE pulse, until FLUSH_TX or W_TX_PAYLOAD
+    if (status == NRF_MNGR_OK)
+    {
+      status = (spi_write_command(driver, REUSE_TX_PL, NULL, ZERO_BYTES, NULL) == SPI_MNGR_OK) ? NRF_MNGR_OK : ERROR;
+    }
+
+    driver->is_beacon_update = false;
+  }
+
+  return status;
+}
+
+
+/**
+ * Stops the beacon, cancelling its repeating timer, once any
+ * transmission in progress has completed. The TX FIFO is then
+ * flushed, ending the reuse of the beacon payload.
+ * 
+ * @param driver nrf_driver_t instance
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_beacon_stop(nrf_driver_t *driver) {
+
+  fn_status_t status = (driver->is_beacon) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    cancel_repeating_timer(&(driver->beacon_timer));
+
+    wait_beacon_airtime(driver);
+
+    // FLUSH_TX ends the reuse of the payload, then TX_DS is reset
+    spi_manager_frame_t frames[2] = {
+      { .tx_buffer = (uint8_t[]){ FLUSH_TX }, .rx_buffer = NULL, .len = ONE_BYTE },
+      { .tx_buffer = (uint8_t[]){ (REGISTER_MASK & STATUS) | W_REGISTER, SET_BIT << STATUS_TX_DS }, .rx_buffer = NULL, .len = TWO_BYTES }
+    };
+
+    status = (spi_transfer_batch(driver, frames, 2) == SPI_MNGR_OK) ? NRF_MNGR_OK : ERROR;
+
+    driver->is_beacon = false;
+    driver->mode = STANDBY_I;
+  }
+
+  return status;
+}
+
+
+/**
+ * Starts a duty-cycled receiver, which spends most of each period 
+ * in Power Down mode. An alarm powers the NRF24L01 up at the start
+ * of each period, waits the 1.5ms Power Down to Standby-I time, 
+ * drives CE HIGH for the 130us RX Mode settling time and a listen
+ * window of listen_us, then drives CE LOW and powers it down for 
+ * the rest of the period. RX_READY_EVENT is reported at the start
+ * of each listen window.
+ * 
+ * A packet received in a listen window asserts RX_DR, so the IRQ
+ * pin interrupt drains it into the RX ring, if enabled, and wakes 
+ * a core waiting in __wfe. 
+ * 
+ * @note Transmit functions, nrf_driver_standby_mode and 
+ * nrf_driver_receiver_mode return ERROR, until the duty cycle is
+ * stopped through nrf_driver_duty_cycle_stop. 
+ * 
+ * @param driver nrf_driver_t instance
+ * @param period_us duty cycle period (us)
+ * @param listen_us listen window, after RX Mode has settled (us)
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_duty_cycle_start(nrf_driver_t *driver, uint32_t period_us, uint32_t listen_us) {
+
+  // time spent out of Power Down mode, each period
+  uint32_t active_us = POWER_UP_US + RX_SETTLE_US + listen_us;
+
+  fn_status_t status = (is_tx_idle(driver) && !driver->is_engine && (listen_us > 0) && (period_us > active_us)) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    if (driver->mode == RX_MODE) { nrf_driver_standby_mode(driver); }
+
+    // restore the RX_ADDR_P0 address, if overwritten by tx_destination
+    if (driver->is_rx_addr_p0_stale)
+    {
+      if (w_register(driver, RX_ADDR_P0, driver->rx_addr_p0, driver->address_width_bytes) == SPI_MNGR_OK)
+      {
+        driver->is_rx_addr_p0_stale = false;
+      }
+    }
+
+    // set PRIM_RX bit and clear PWR_UP bit, so the NRF24L01 enters Power Down mode
+    uint8_t config = (driver->shadow[CONFIG] | (SET_BIT << CONFIG_PRIM_RX)) & ~(SET_BIT << CONFIG_PWR_UP);
+
+    status = (w_shadow_register(driver, CONFIG, config) == SPI_MNGR_OK) ? NRF_MNGR_OK : ERROR;
+  }
+
+  if (status == NRF_MNGR_OK)
+  {
+    driver->mode = POWER_DOWN;
+
+    driver->duty_period_us = period_us;
+    driver->duty_listen_us = listen_us;
+    driver->duty_phase = DUTY_WAKE;
+    driver->is_duty_cycle = true;
+
+    // the first period starts after its Power Down time
+    driver->duty_alarm = add_alarm_in_us(period_us - active_us, duty_cycle_callback, driver, true);
+
+    if (driver->duty_alarm <= 0)
+    {
+      driver->duty_alarm = 0;
+
+      nrf_driver_duty_cycle_stop(driver);
+
+      status = ERROR;
+    }
+  }
+
+  return status;
+}
+
+
+/**
+ * Stops the duty-cycled receiver, cancelling its alarm, and 
+ * leaves the NRF24L01 powered up in Standby-I mode. If it was 
+ * powered down, the 1.5ms Power Down to Standby-I time is 
+ * completed by an alarm, rather than waited for, after which 
+ * a core waiting in __wfe is woken.
+ * 
+ * @note Transmit functions, nrf_driver_standby_mode and 
+ * nrf_driver_receiver_mode return ERROR, until the NRF24L01
+ * has powered up.
+ * 
+ * @param driver nrf_driver_t instance
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_duty_cycle_stop(nrf_driver_t *driver) {
+
+  // a duty cycle which is already powering up is not stopped again
+  fn_status_t status = (driver->is_duty_cycle && (driver->duty_phase != DUTY_STOP)) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    alarm_id_t alarm = driver->duty_alarm;
+
+    if (alarm > 0) { cancel_alarm(alarm); }
+
+    driver->duty_alarm = 0;
+
+    // Drive CE LOW, ending a listen window in progress
+    ce_put_low(driver->user_pins.ce);
+
+    driver->is_rx_ready = false;
+
+    // powered down, or powering up in the DUTY_LISTEN phase
+    bool is_power_down = !((driver->shadow[CONFIG] >> CONFIG_PWR_UP) & SET_BIT) || (driver->duty_phase == DUTY_LISTEN);
+
+    // set PWR_UP bit and clear PRIM_RX bit, for Standby-I mode
+    uint8_t config = (driver->shadow[CONFIG] | (SET_BIT << CONFIG_PWR_UP)) & ~(SET_BIT << CONFIG_PRIM_RX);
+
+    status = (w_shadow_register(driver, CONFIG, config) == SPI_MNGR_OK) ? NRF_MNGR_OK : ERROR;
+
+    if (is_power_down)
+    {
+      // NRF24L01+ enters Standby-I mode after 1.5ms, completed by duty_cycle_callback
+      driver->duty_phase = DUTY_STOP;
+      driver->duty_alarm = add_alarm_in_us(POWER_UP_US, duty_cycle_callback, driver, true);
+    }
+
+    // no alarm was free, so the power up time is waited for
+    if (driver->duty_alarm <= 0)
+    {
+      driver->duty_alarm = 0;
+
+      if (is_power_down) { busy_wait_us_32(POWER_UP_US); }
+
+      driver->is_duty_cycle = false;
+      driver->mode = STANDBY_I;
+    }
+  }
+
+  return status;
+}
+
+
+/**
+ * Read an available packet from the RX FIFO into the 
+ * buffer (rx_packet).
+ * 
+ * @param driver nrf_driver_t instance
+ * @param rx_packet packet buffer for receipt
+ * @param size size of buffer
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+fn_status_t nrf_driver_read_packet(nrf_driver_t *driver, void *rx_packet, size_t size) {
+
+  // cast void *rx_packet to uint8_t pointer
+  uint8_t *rx_packet_ptr = (uint8_t *)rx_packet;
+
+  // R_RX_PAYLOAD command + packet_size
+  size_t total_size = size + 1;
+
+  uint8_t tx_buffer[total_size]; // SPI transfer TX buffer
+  uint8_t rx_buffer[total_size]; // SPI transfer RX buffer
+
+  // put R_RX_PAYLOAD command into first index of tx_buffer
+  tx_buffer[0] = R_RX_PAYLOAD;
+
+  // fill rest of tx_buffer with NOP
+  for (size_t i = 1; i < total_size; i++) { *(tx_buffer + i) = NOP; }
+
+  // R_RX_PL_WID command response, rx_width[0] holds STATUS register value
+  uint8_t rx_width[TWO_BYTES] = { 0, 0 };
+
+  spi_manager_frame_t frames[2] = {
+    { .tx_buffer = (uint8_t[]){ R_RX_PL_WID, NOP }, .rx_buffer = rx_width, .len = TWO_BYTES },
+    { .tx_buffer = tx_buffer, .rx_buffer = rx_buffer, .len = total_size }
+  };
+
+  bool is_dyn_payloads = (driver->user_config.dyn_payloads == DYNPD_ENABLE);
+
+  /**
+   * if dynamic payloads are enabled, the payload width is read
+   * via the R_RX_PL_WID command, in the same batch as the payload
+   * is read via the R_RX_PAYLOAD command. 
+   */
+  fn_status_t status = (is_dyn_payloads) ? spi_transfer_batch(driver, frames, 2) : spi_transfer_batch(driver, &frames[1], 1);
+
+  /**
+   * a payload width greater than 32 (max payload size) means the
+   * packet is corrupted and RX FIFO is flushed. 
+   */
+  if (is_dyn_payloads && (rx_width[1] > MAX_BYTES)) 
+  {
+    flush_rx_fifo(driver);
+    status = ERROR;
+  }
+
+  if (status)
+  {
+    // skip rx_buffer[0] (STATUS value) and transfer remaining values to buffer
+    for (size_t i = 0; i < size; i++)
+    { 
+      *(rx_packet_ptr + i) = rx_buffer[i + 1]; 
+    }
+  }
+
+  return status;
+}
+
+
+/**
+ * Polls the STATUS register to ascertain if there is a packet 
+ * in the RX FIFO. The function will return PASS (1) if there 
+ * is a packet available to read, or FAIL (0) if not. 
+ * 
+ * @note RX_DR reset by another poll, such as nrf_driver_poll_tx,
+ * is held as an event, which is consumed here.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param rx_p_no data pipe number or NULL
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_is_packet(nrf_driver_t *driver, uint8_t *rx_p_no) {
+
+  /**
+   * poll_status_events function checks if uint8_t *rx_p_no
+   * argument is NULL. If not, the data pipe number of the 
+   * packet at the top of the RX FIFO will be passed to rx_p_no
+   */
+  poll_status_events(driver, rx_p_no);
+
+  fn_status_t status = (consume_events(driver, RX_DR_EVENT)) ? NRF_MNGR_OK : ERROR;
+
+  // a held RX_DR event, without STATUS read by this poll
+  if ((status == NRF_MNGR_OK) && (rx_p_no != NULL) && (*rx_p_no >= ALL_DATA_PIPES))
+  {
+    *rx_p_no = (r_status(driver) >> STATUS_RX_P_NO) & STATUS_RX_P_NO_MASK;
+  }
+
+  return status;
+}
+
+
+/**
+ * Polls the STATUS register and passes every event held, as a 
+ * bitmask of fn_status_event_t, to events. RX_DR_EVENT, TX_DS_EVENT
+ * and MAX_RT_EVENT are consumed, so a TX completion and a received
+ * packet in the same poll are both reported. TX_FULL_EVENT is set 
+ * if the TX FIFO was full when STATUS was read. RX_READY_EVENT is 
+ * reported once, after nrf_driver_receiver_mode, once the NRF24L01
+ * has settled in RX Mode.
+ * 
+ * @note A TX_DS_EVENT or MAX_RT_EVENT consumed here completes a 
+ * packet sent by nrf_driver_send_packet_async, without a call to
+ * the nrf_driver_tx_callback callback.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param events bitmask of fn_status_event_t
+ * @param rx_p_no data pipe number (7 if RX FIFO empty or not read) or NULL
+ * 
+ * @return NRF_MNGR_OK (3) if an IRQ event or RX_READY_EVENT was held, ERROR (0)
+ */
+fn_status_t nrf_driver_poll_events(nrf_driver_t *driver, uint8_t *events, uint8_t *rx_p_no) {
+
+  uint8_t status_events = poll_status_events(driver, rx_p_no);
+
+  uint8_t irq_events = consume_events(driver, RX_DR_EVENT | TX_DS_EVENT | MAX_RT_EVENT);
+
+  if (irq_events & (TX_DS_EVENT | MAX_RT_EVENT)) { driver->is_tx_pending = false; }
+
+  // RX Mode settling time completed, reported once
+  if (driver->is_rx_ready)
+  {
+    driver->is_rx_ready = false;
+
+    status_events |= RX_READY_EVENT;
+  }
+
+  *events = status_events;
+
+  fn_status_t status = (irq_events || (status_events & RX_READY_EVENT)) ? NRF_MNGR_OK : ERROR;
+
+  return status;
+}
+
+
+/**
+ * Reads every packet in the RX FIFO into rx_packets, with the 
+ * data pipe each was received on and its width, in payload order.
+ * FIFO_STATUS is read once and then with each payload, in the same
+ * batch, along with the width of the next payload, if dynamic 
+ * payloads are enabled. RX_DR is reset only once FIFO_STATUS 
+ * reports the RX FIFO is empty, so it remains asserted, if 
+ * max_packets were read before the RX FIFO was emptied.
+ * 
+ * @note A packet with an invalid width is corrupt and the RX FIFO
+ * is flushed.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param rx_packets array of rx_packet_t structs
+ * @param max_packets number of rx_packet_t structs in rx_packets
+ * @param count number of packets read or NULL
+ * 
+ * @return NRF_MNGR_OK (3) if a packet was read, ERROR (0)
+ */
+fn_status_t nrf_driver_receive_batch(nrf_driver_t *driver, rx_packet_t *rx_packets, size_t max_packets, size_t *count) {
+
+  bool is_dyn_payloads = (driver->user_config.dyn_payloads == DYNPD_ENABLE);
+
+  // R_REGISTER FIFO_STATUS and R_RX_PL_WID responses, index 0 holds STATUS register value
+  uint8_t rx_fifo_status[TWO_BYTES] = { 0, 0 };
+  uint8_t rx_width[TWO_BYTES] = { 0, 0 };
+
+  // R_RX_PAYLOAD command + NOP bytes and the response, index 0 holds STATUS register value
+  uint8_t tx_payload[MAX_BYTES + 1];
+  uint8_t rx_payload[MAX_BYTES + 1];
+
+  memset(tx_payload, NOP, sizeof(tx_payload));
+  tx_payload[0] = R_RX_PAYLOAD;
+
+  spi_manager_frame_t frames[3] = {
+    { .tx_buffer = tx_payload, .rx_buffer = rx_payload, .len = ONE_BYTE },
+    { .tx_buffer = (uint8_t[]){ FIFO_STATUS | R_REGISTER, NOP }, .rx_buffer = rx_fifo_status, .len = TWO_BYTES },
+    { .tx_buffer = (uint8_t[]){ R_RX_PL_WID, NOP }, .rx_buffer = rx_width, .len = TWO_BYTES }
+  };
+
+  // STATUS register is read below, so a latched IRQ pin interrupt is consumed
+  driver->is_irq_pending = false;
+
+  // FIFO_STATUS (and width of the first payload) read once, up front
+  fn_status_t status = spi_transfer_batch(driver, &frames[1], (is_dyn_payloads) ? 2 : 1);
+
+  size_t received = 0;
+
+  while ((status == SPI_MNGR_OK) && (received < max_packets) && !((rx_fifo_status[1] >> FIFO_STATUS_RX_EMPTY) & SET_BIT))
+  {
+    // data pipe of the payload at the top of the RX FIFO
+    uint8_t rx_p_no = (rx_fifo_status[0] >> STATUS_RX_P_NO) & STATUS_RX_P_NO_MASK;
+
+    uint8_t width = (is_dyn_payloads) ? rx_width[1] : ((rx_p_no < ALL_DATA_PIPES) ? driver->shadow[RX_PW_P0 + rx_p_no] : 0);
+
+    // a payload width greater than 32 (max payload size) means the packet is corrupted
+    if ((rx_p_no >= ALL_DATA_PIPES) || (width == ZERO_BYTES) || (width > MAX_BYTES))
+    {
+      flush_rx_fifo(driver);
+      status = ERROR;
+      break;
+    }
+
+    frames[0].len = width + 1;
+
+    // payload, FIFO_STATUS and width of the next payload, in one batch
+    status = spi_transfer_batch(driver, frames, (is_dyn_payloads) ? 3 : 2);
+
+    if (status == SPI_MNGR_OK)
+    {
+      rx_packet_t *rx_packet = &(rx_packets[received++]);
+
+      // skip rx_payload[0] (STATUS value)
+      memcpy(rx_packet->payload, &rx_payload[1], width);
+
+      rx_packet->width = width;
+      rx_packet->data_pipe = (data_pipe_t)rx_p_no;
+      rx_packet->timestamp_us = time_us_32();
+    }
+  }
+
+  if ((status == SPI_MNGR_OK) && ((rx_fifo_status[1] >> FIFO_STATUS_RX_EMPTY) & SET_BIT))
+  {
+    // reset RX_DR (bit 6) in STATUS register and read FIFO_STATUS again, in one batch
+    frames[0] = (spi_manager_frame_t){ .tx_buffer = (uint8_t[]){ STATUS | W_REGISTER, SET_BIT << STATUS_RX_DR }, .rx_buffer = NULL, .len = TWO_BYTES };
+
+    status = spi_transfer_batch(driver, frames, 2);
+
+    // every packet was read, so a held RX_DR event is consumed
+    consume_events(driver, RX_DR_EVENT);
+
+    // a packet received before RX_DR was reset is latched, as its RX_DR was reset
+    if (!((rx_fifo_status[1] >> FIFO_STATUS_RX_EMPTY) & SET_BIT)) { driver->is_irq_pending = true; }
+  }
+
+  // an IRQ bit asserted after STATUS was read holds the IRQ pin LOW
+  if ((driver->irq_pin != IRQ_PIN_UNUSED) && irq_is_low(driver->irq_pin)) { driver->is_irq_pending = true; }
+
+  if (count != NULL) { *count = received; }
+
+  status = ((status == SPI_MNGR_OK) && (received > 0)) ? NRF_MNGR_OK : ERROR;
+
+  return status;
+}
+
+
+/**
+ * Enables a software RX ring of depth rx_packet_t slots, which 
+ * the RX FIFO is drained into by the IRQ pin interrupt, in RX 
+ * Mode, absorbing bursts of packets whilst the program is busy.
+ * Packets are taken from the RX ring by nrf_driver_rx_ring_pop.
+ * Without an IRQ pin, nrf_driver_rx_ring_pop drains the RX FIFO.
+ * 
+ * @note Once enabled, packets should only be read through the RX 
+ * ring, as the interrupt may drain the RX FIFO between the SPI 
+ * transfers of nrf_driver_read_packet or nrf_driver_receive_batch.
+ * The interrupt must be handled on the core calling the driver.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param slots array of rx_packet_t structs or NULL (disable)
+ * @param depth number of slots in slots (power of 2)
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_rx_ring(nrf_driver_t *driver, rx_packet_t *slots, size_t depth) {
+
+  // depth must be a power of 2, so free running indices wrap correctly
+  fn_status_t status = ((slots == NULL) || ((depth > 0) && !(depth & (depth - 1)))) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    // disabled, before the indices are reset, so irq_handler does not drain
+    driver->rx_ring = NULL;
+
+    __dmb();
+
+    driver->rx_ring_depth = depth;
+    driver->rx_ring_head = 0;
+    driver->rx_ring_tail = 0;
+    driver->rx_ring_overflows = 0;
+
+    __dmb();
+
+    driver->rx_ring = slots;
+  }
+
+  return status;
+}
+
+
+/**
+ * Takes the oldest packet from the RX ring, without waiting. If 
+ * the RX ring is empty and the RX FIFO has not been drained, as 
+ * there is no IRQ pin, or the interrupt preempted an SPI transfer, 
+ * the RX FIFO is drained into the RX ring first.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param rx_packet rx_packet_t struct for the packet
+ * 
+ * @return NRF_MNGR_OK (3) if a packet was taken, ERROR (0)
+ */
+fn_status_t nrf_driver_rx_ring_pop(nrf_driver_t *driver, rx_packet_t *rx_packet) {
+
+  fn_status_t status = (driver->rx_ring != NULL) ? NRF_MNGR_OK : ERROR;
+
+  uint32_t tail = driver->rx_ring_tail;
+
+  if ((status == NRF_MNGR_OK) && (tail == driver->rx_ring_head) && (driver->mode == RX_MODE) && !driver->is_engine)
+  {
+    if ((driver->irq_pin == IRQ_PIN_UNUSED) || driver->is_irq_pending || (driver->events & RX_DR_EVENT))
+    {
+      // held, so irq_handler does not drain at the same time
+      hold_spi(driver);
+
+      drain_rx_ring(driver);
+
+      release_spi(driver);
+    }
+  }
+
+  status = ((status == NRF_MNGR_OK) && (tail != driver->rx_ring_head)) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    // slot read after the head was published by the producer
+    __dmb();
+
+    *rx_packet = driver->rx_ring[tail & (driver->rx_ring_depth - 1)];
+
+    // slot read before it is released to the producer
+    __dmb();
+
+    driver->rx_ring_tail = tail + 1;
+  }
+
+  return status;
+}
+
+
+/**
+ * Copies the number of packets held in the RX ring and the 
+ * number of packets discarded, as the RX ring was full.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param count packets held or NULL
+ * @param overflows packets discarded or NULL
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0) if the RX ring is disabled
+ */
+fn_status_t nrf_driver_rx_ring_stats(nrf_driver_t *driver, size_t *count, uint32_t *overflows) {
+
+  fn_status_t status = (driver->rx_ring != NULL) ? NRF_MNGR_OK : ERROR;
+
+  if (count != NULL) { *count = driver->rx_ring_head - driver->rx_ring_tail; }
+
+  if (overflows != NULL) { *overflows = driver->rx_ring_overflows; }
+
+  return status;
+}
+
+
+/**
+ * Enables a software TX queue of depth tx_entry_t entries, with
+ * optional results of the same depth. Packets queued through
+ * nrf_driver_tx_enqueue are moved into the TX FIFO as TX_DS or
+ * MAX_RT free its slots, by the IRQ pin interrupt, and their
+ * outcomes are taken through nrf_driver_tx_result. Without an 
+ * IRQ pin, the TX queue is moved along by nrf_driver_tx_result.
+ * 
+ * @note The TX queue can only be disabled (entries NULL), or 
+ * enabled again, once every queued packet has completed. 
+ * nrf_driver_send_packet_async and nrf_driver_send_stream return
+ * ERROR, whilst queued packets are in flight.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param entries array of tx_entry_t structs or NULL (disable)
+ * @param results array of tx_result_t structs or NULL
+ * @param depth number of entries in entries and results (power of 2)
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_tx_queue(nrf_driver_t *driver, tx_entry_t *entries, tx_result_t *results, size_t depth) {
+
+  // depth must be a power of 2, so free running indices wrap correctly
+  fn_status_t status = ((entries == NULL) || ((depth > 0) && !(depth & (depth - 1)))) ? NRF_MNGR_OK : ERROR;
+
+  if (driver->tx_queue_head != driver->tx_queue_tail) { status = ERROR; }
+
+  if (status == NRF_MNGR_OK)
+  {
+    // disabled, before the indices are reset, so irq_handler does not pump
+    driver->tx_queue = NULL;
+
+    __dmb();
+
+    driver->tx_results = results;
+    driver->tx_queue_depth = depth;
+    driver->tx_queue_head = 0;
+    driver->tx_queue_upload = 0;
+    driver->tx_queue_tail = 0;
+    driver->tx_results_head = 0;
+    driver->tx_results_tail = 0;
+
+    __dmb();
+
+    driver->tx_queue = entries;
+  }
+
+  return status;
+}
+
+
+/**
+ * Copies a packet into the TX queue, without waiting for it to be 
+ * transmitted, and uploads it to the TX FIFO, if there is a free 
+ * slot. The sequence number passed to sequence identifies its 
+ * outcome, taken through nrf_driver_tx_result.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param tx_packet packet for transmission
+ * @param size size of tx_packet
+ * @param sequence sequence number of the packet or NULL
+ * 
+ * @return QUEUE_OK (2), QUEUE_FULL (1), QUEUE_ERROR (0)
+ */
+fn_status_queue_t nrf_driver_tx_enqueue(nrf_driver_t *driver, const void *tx_packet, size_t size, uint32_t *sequence) {
+
+  tx_entry_t *queue = driver->tx_queue;
+
+  fn_status_queue_t status = ((queue != NULL) && !driver->is_beacon && !driver->is_duty_cycle && (size > ZERO_BYTES) && (size <= MAX_BYTES)) ? QUEUE_OK : QUEUE_ERROR;
+
+  uint32_t head = driver->tx_queue_head;
+
+  // entries are freed by pump_tx_queue, as their outcomes are known
+  if ((status == QUEUE_OK) && ((head - driver->tx_queue_tail) >= driver->tx_queue_depth)) { status = QUEUE_FULL; }
+
+  if (status == QUEUE_OK)
+  {
+    tx_entry_t *entry = &queue[head & (driver->tx_queue_depth - 1)];
+
+    memcpy(entry->payload, tx_packet, size);
+    entry->width = size;
+
+    // entry written before the head is published to the consumer
+    __dmb();
+
+    driver->tx_queue_head = head + 1;
+
+    if (sequence != NULL) { *sequence = head; }
+
+    if ((driver->mode == RX_MODE) && !driver->is_engine) { nrf_driver_standby_mode(driver); }
+
+    if (driver->is_engine)
+    {
+      // the radio engine on core 1 uploads the packet
+      __sev();
+
+    } else {
+
+      // held, so irq_handler does not pump at the same time
+      hold_spi(driver);
+
+      // upload the packet, if there is a free TX FIFO slot
+      if ((driver->tx_queue_upload - driver->tx_queue_tail) < 3) { pump_tx_queue(driver); }
+
+      release_spi(driver);
+    }
+  }
+
+  return status;
+}
+
+
+/**
+ * Takes the oldest outcome of a packet queued through 
+ * nrf_driver_tx_enqueue, without waiting. Without an IRQ 
+ * pin, or if the interrupt preempted an SPI transfer, the 
+ * TX queue is pumped first.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param result tx_result_t struct for the outcome
+ * 
+ * @return NRF_MNGR_OK (3) if an outcome was taken, ERROR (0)
+ */
+fn_status_t nrf_driver_tx_result(nrf_driver_t *driver, tx_result_t *result) {
+
+  fn_status_t status = (driver->tx_queue != NULL) ? NRF_MNGR_OK : ERROR;
+
+  if ((status == NRF_MNGR_OK) && (driver->tx_queue_head != driver->tx_queue_tail) && !driver->is_engine)
+  {
+    if ((driver->irq_pin == IRQ_PIN_UNUSED) || driver->is_irq_pending)
+    {
+      // held, so irq_handler does not pump at the same time
+      hold_spi(driver);
+
+      pump_tx_queue(driver);
+
+      release_spi(driver);
+    }
+  }
+
+  uint32_t tail = driver->tx_results_tail;
+
+  status = ((status == NRF_MNGR_OK) && (driver->tx_results != NULL) && (tail != driver->tx_results_head)) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    // result read after the head was published by the producer
+    __dmb();
+
+    *result = driver->tx_results[tail & (driver->tx_queue_depth - 1)];
+
+    // result read before it is released to the producer
+    __dmb();
+
+    driver->tx_results_tail = tail + 1;
+  }
+
+  return status;
+}
+
+
+/**
+ * Starts the radio engine on core 1, which then owns the SPI 
+ * interface, the IRQ pin and the NRF24L01 mode. Core 0 submits 
+ * packets through nrf_driver_tx_enqueue, takes their outcomes 
+ * through nrf_driver_tx_result and takes received packets through 
+ * nrf_driver_rx_ring_pop, which neither wait nor use SPI whilst 
+ * the radio engine runs. With the RX ring enabled, the radio 
+ * engine listens in RX Mode, whenever the TX queue is empty.
+ * 
+ * @note The TX queue or RX ring (or both) must be enabled first.
+ * No other function of the instance may be called, until the 
+ * radio engine is stopped by nrf_driver_engine_stop. Core 1 must
+ * be free, as it is launched through multicore_launch_core1.
+ * 
+ * No interrupt of the instance is taken on core 0, whilst the 
+ * radio engine runs. The IRQ pin level is polled, DMA transfers
+ * are polled to completion (see spi_manager_transfer_dma) and the
+ * RX Mode settling time and CE pulses are waited for on core 1, 
+ * in place of alarms.
+ * 
+ * @param driver nrf_driver_t instance
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_engine_start(nrf_driver_t *driver) {
+
+  bool is_queue = (driver->tx_queue != NULL) || (driver->rx_ring != NULL);
+
+  // one radio engine, for one instance
+  fn_status_t status = (driver->is_spi_session && is_queue && !driver->is_duty_cycle && (engine_driver == NULL)) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    // the radio engine polls the IRQ pin level on core 1, in place of the interrupt
+    if (driver->irq_pin != IRQ_PIN_UNUSED) { pin_manager_release_irq(driver->irq_pin, driver->irq_handler); }
+
+    engine_driver = driver;
+
+    driver->is_engine = true;
+    driver->is_engine_running = true;
+
+    multicore_launch_core1(engine_main);
+  }
+
+  return status;
+}
+
+
+/**
+ * Stops the radio engine on core 1, once its current pass has
+ * completed, and resets core 1. The IRQ pin interrupt is enabled
+ * again, if there is an IRQ pin.
+ * 
+ * @param driver nrf_driver_t instance
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_engine_stop(nrf_driver_t *driver) {
+
+  fn_status_t status = (engine_driver == driver) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    driver->is_engine = false;
+
+    __sev();
+
+    // wait for the radio engine to complete its current pass
+    while (driver->is_engine_running) { tight_loop_contents(); }
+
+    multicore_reset_core1();
+
+    engine_driver = NULL;
+
+    if (driver->irq_pin != IRQ_PIN_UNUSED)
+    {
+      // latched, so IRQ bits asserted whilst the interrupt was disabled are read
+      driver->is_irq_pending = true;
+
+      status = (pin_manager_configure_irq(driver->irq_pin, driver->irq_handler) == PIN_MNGR_OK) ? NRF_MNGR_OK : ERROR;
+    }
+  }
+
+  return status;
+}
+
+
+/**
+ * Puts the NRF24L01 into RX Mode. Sets the CONFIG register 
+ * PRIM_RX bit value and drive CE pin HIGH. Only registers which
+ * changed are written. The 130us RX Mode settling time is 
+ * completed by an alarm, rather than waited for, and reported 
+ * as RX_READY_EVENT by nrf_driver_poll_events.
+ * 
+ * NOTE: State diagram in the datasheet (6.1.1) highlights
+ * conditions for entering Rx and Tx operating modes. One 
+ * condition is the value of PRIM_RX (bit 0) in the CONFIG
+ * register. PRIM_RX = 1 for Rx mode or 0 for Tx mode. CE
+ * pin is driven HIGH for Rx mode and is only driven high 
+ * in Tx mode to facilitate the Tx of data (10us+).
+ * 
+ * @param driver nrf_driver_t instance
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+fn_status_t nrf_driver_receiver_mode(nrf_driver_t *driver) {
+
+  // the duty cycle switches modes, until nrf_driver_duty_cycle_stop
+  fn_status_t status = (!driver->is_duty_cycle) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    // shadow value of CONFIG register
+    uint8_t config = driver->shadow[CONFIG];
+
+    // is CONFIG register PRIM_RX bit set?
+    uint8_t prim_rx = (config >> CONFIG_PRIM_RX) & 1;
+
+    // PRIM_RX bit should be set for RX Mode
+    if (prim_rx != SET_BIT)
+    {
+      // set PRIM_RX bit in CONFIG register
+      status = w_shadow_register(driver, CONFIG, config | (SET_BIT << CONFIG_PRIM_RX));
+    }
+
+    // restore the RX_ADDR_P0 address, if overwritten by tx_destination
+    if (driver->is_rx_addr_p0_stale)
+    {
+      if (w_register(driver, RX_ADDR_P0, driver->rx_addr_p0, driver->address_width_bytes) == SPI_MNGR_OK)
+      {
+        driver->is_rx_addr_p0_stale = false;
+      }
+    }
+
+    if (driver->mode != RX_MODE)
+    {
+      // Drive CE HIGH, held beyond a CE pulse in progress
+      cancel_ce_pulse(driver);
+      ce_put_high(driver->user_pins.ce);
+
+      // NRF24L01+ enters RX Mode after 130μS, completed by rx_settle_callback
+      cancel_rx_settle(driver);
+
+      driver->is_rx_ready = false;
+
+      // the radio engine takes no alarm interrupt on core 0, so it waits on core 1
+      driver->rx_settle_alarm = (!driver->is_engine) ? add_alarm_in_us(RX_SETTLE_US, rx_settle_callback, driver, true) : 0;
+
+      // no alarm was free, so the settling time is waited for
+      if (driver->rx_settle_alarm <= 0)
+      {
+        driver->rx_settle_alarm = 0;
+
+        busy_wait_us_32(RX_SETTLE_US);
+
+        driver->is_rx_ready = true;
+      }
+    }
+
+    driver->mode = RX_MODE; // reflect RX Mode in nrf_status
+  }
+
+  return status;
+}
+
+
+/**
+ * Sets the CSN setup time (CSN LOW to first SCK edge) and 
+ * hold time (last SCK edge to CSN HIGH) for SPI transfers 
+ * to the NRF24L01. No delay is applied by default, as the 
+ * datasheet Tcc and Tcch (2nS) are met without one.
+ * 
+ * @note Call after nrf_driver_configure, which sets the 
+ * SPI instance the timing applies to. The PIO transport
+ * (nrf_driver_configure_pio) frames CSN itself, with fixed
+ * timing, so ERROR (0) is returned for a PIO instance and
+ * no timing is changed.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param setup_ns CSN setup time in nS (0 for none)
+ * @param hold_ns CSN hold time in nS (0 for none)
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+fn_status_t nrf_driver_csn_timing(nrf_driver_t *driver, uint32_t setup_ns, uint32_t hold_ns) {
+
+  // user_spi.instance of a PIO instance is unused and may be the SPI instance of another driver
+  fn_status_t status = (driver->is_pio_spi) ? ERROR : SPI_MNGR_OK;
+
+  if (status == SPI_MNGR_OK) { spi_manager_csn_timing(driver->user_spi.instance, setup_ns, hold_ns); }
+
+  return status;
+}
+
+
+/**
+ * Sets the width of the CE pulse, which starts a transmission in
+ * nrf_driver_send_packet_async, nrf_driver_send_packet_noack and 
+ * the beacon. The pulse is ended by an alarm, so a send returns
+ * without waiting for it.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param width_us CE pulse width (us), 10us minimum
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_ce_pulse(nrf_driver_t *driver, uint32_t width_us) {
+
+  fn_status_t status = (width_us >= CE_PULSE_US) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK) { driver->ce_pulse_us = width_us; }
+
+  return status;
+}
+
+
+/**
+ * Closes the SPI session opened by nrf_driver_configure or 
+ * nrf_driver_configure_pio. The NRF24L01 can not be 
+ * communicated with until the driver is configured again.
+ * 
+ * @param driver nrf_driver_t instance
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+fn_status_t nrf_driver_close(nrf_driver_t *driver) {
+
+  fn_status_t status = (driver->is_spi_session) ? SPI_MNGR_OK : ERROR;
+
+  close_spi_session(driver);
+
+  return status;
+}
+
+
+/**
+ * Reads every register held in the shadow in one batch and
+ * compares them with the shadow values. Any register which
+ * does not hold its shadow value (after a brown-out reset of
+ * the NRF24L01, for example) is rewritten from the shadow.
+ * 
+ * @param driver nrf_driver_t instance
+ * 
+ * @return NRF_MNGR_OK (3) if the registers matched the shadow, 
+ * ERROR (0) if a register was rewritten or the SPI transfer failed
+ */
+fn_status_t nrf_driver_sync_registers(nrf_driver_t *driver) {
+
+  // R_REGISTER command + NOP for each register
+  uint8_t tx_buffers[SHADOW_REGISTERS][TWO_BYTES];
+  uint8_t rx_buffers[SHADOW_REGISTERS][TWO_BYTES];
+  spi_manager_frame_t frames[SHADOW_REGISTERS];
+
+  for (size_t i = 0; i < SHADOW_REGISTERS; i++)
+  {
+    tx_buffers[i][0] = (REGISTER_MASK & shadow_registers[i]) | R_REGISTER;
+    tx_buffers[i][1] = NOP;
+
+    frames[i] = (spi_manager_frame_t){ .tx_buffer = tx_buffers[i], .rx_buffer = rx_buffers[i], .len = TWO_BYTES };
+  }
+
+  // register values are only compared, if the batch was clocked
+  bool is_read = (spi_transfer_batch(driver, frames, SHADOW_REGISTERS) == SPI_MNGR_OK);
+
+  fn_status_t status = (is_read) ? NRF_MNGR_OK : ERROR;
+
+  for (size_t i = 0; is_read && (i < SHADOW_REGISTERS); i++)
+  {
+    register_map_t reg = shadow_registers[i];
+
+    // rx_buffers[i][0] holds STATUS register value
+    if (rx_buffers[i][1] != driver->shadow[reg])
+    {
+      w_register(driver, reg, &(driver->shadow[reg]), ONE_BYTE);
+      status = ERROR;
+    }
+  }
+
+  return status;
+}
+
+
+/**
+ * Copies the current NRF24L01 configuration, held in the 
+ * register shadow, into the nrf_manager_t argument, without 
+ * an SPI transfer.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param user_config nrf_manager_t struct
+ * 
+ * @return NRF_MNGR_OK (3)
+ */
+fn_status_t nrf_driver_get_config(nrf_driver_t *driver, nrf_manager_t *user_config) {
+
+  const uint8_t *shadow = driver->shadow;
+
+  user_config->address_width = (address_width_t)shadow[SETUP_AW];
+  user_config->dyn_payloads = (shadow[DYNPD] != DYNPD_DISABLE) ? DYNPD_ENABLE : DYNPD_DISABLE;
+  user_config->retr_delay = (retr_delay_t)(shadow[SETUP_RETR] & 0xF0);
+  user_config->retr_count = (retr_count_t)(shadow[SETUP_RETR] & 0x0F);
+  user_config->data_rate = (rf_data_rate_t)(shadow[RF_SETUP] & RF_SETUP_RF_DR_MASK);
+  user_config->power = (rf_power_t)(shadow[RF_SETUP] & RF_SETUP_RF_PWR_MASK);
+  user_config->channel = shadow[RF_CH];
+
+  return NRF_MNGR_OK;
+}
+
+
+/**
+ * Copies the STATUS register value last clocked in by a command 
+ * into status_reg, without an SPI transfer. IRQ bits shown are 
+ * still asserted, but a bit asserted since may not be shown.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param status_reg STATUS register value
+ * 
+ * @return NRF_MNGR_OK (3)
+ */
+fn_status_t nrf_driver_last_status(nrf_driver_t *driver, uint8_t *status_reg) {
+
+  *status_reg = driver->status_reg;
+
+  return NRF_MNGR_OK;
+}
+
+
+/**
+ * Defines nrf_client_t functions, which call the nrf_driver
+ * function of the same name with the nrf_drivers[n] instance, 
+ * the raw GPIO IRQ handler of the instance and nrf_driver_bind_n,
+ * which assigns them to an nrf_client_t.
+ * This keeps the nrf_client_t function pointer signatures free
+ * of a driver argument.
+ * 
+ * @param n index into nrf_drivers
+ */
+#define NRF_DRIVER_BIND(n) \
+  static fn_status_t nrf_driver_##n##_configure(pin_manager_t *user_pins, uint32_t baudrate_hz) { return nrf_driver_configure(&nrf_drivers[n], user_pins, baudrate_hz); } \
+  static fn_status_t nrf_driver_##n##_configure_pio(pin_manager_t *user_pins, uint32_t baudrate_hz) { return nrf_driver_configure_pio(&nrf_drivers[n], user_pins, baudrate_hz); } \
+  static fn_status_t nrf_driver_##n##_initialise(nrf_manager_t *user_config) { return nrf_driver_initialise(&nrf_drivers[n], user_config); } \
+  static fn_status_t nrf_driver_##n##_rx_destination(data_pipe_t data_pipe, const uint8_t *buffer) { return nrf_driver_rx_destination(&nrf_drivers[n], data_pipe, buffer); } \
+  static fn_status_t nrf_driver_##n##_tx_destination(const uint8_t *buffer) { return nrf_driver_tx_destination(&nrf_drivers[n], buffer); } \
+  static fn_status_t nrf_driver_##n##_payload_size(data_pipe_t data_pipe, size_t size) { return nrf_driver_payload_size(&nrf_drivers[n], data_pipe, size); } \
+  static fn_status_t nrf_driver_##n##_dyn_payloads_enable(void) { return nrf_driver_dyn_payloads_enable(&nrf_drivers[n]); } \
+  static fn_status_t nrf_driver_##n##_dyn_payloads_disable(void) { return nrf_driver_dyn_payloads_disable(&nrf_drivers[n]); } \
+  static fn_status_t nrf_driver_##n##_ack_payloads_enable(void) { return nrf_driver_ack_payloads_enable(&nrf_drivers[n]); } \
+  static fn_status_t nrf_driver_##n##_ack_payloads_disable(void) { return nrf_driver_ack_payloads_disable(&nrf_drivers[n]); } \
+  static fn_status_t nrf_driver_##n##_ack_payload(data_pipe_t data_pipe, const void *payload, size_t size) { return nrf_driver_ack_payload(&nrf_drivers[n], data_pipe, payload, size); } \
+  static fn_status_t nrf_driver_##n##_auto_retransmission(retr_delay_t delay, retr_count_t count) { return nrf_driver_auto_retransmission(&nrf_drivers[n], delay, count); } \
+  static fn_status_t nrf_driver_##n##_rf_channel(uint8_t channel) { return nrf_driver_rf_channel(&nrf_drivers[n], channel); } \
+  static fn_status_t nrf_driver_##n##_rf_data_rate(rf_data_rate_t data_rate) { return nrf_driver_rf_data_rate(&nrf_drivers[n], data_rate); } \
+  static fn_status_t nrf_driver_##n##_rf_power(rf_power_t rf_pwr) { return nrf_driver_rf_power(&nrf_drivers[n], rf_pwr); } \
+  static fn_status_t nrf_driver_##n##_send_packet(const void *tx_packet, size_t size) { return nrf_driver_send_packet(&nrf_drivers[n], tx_packet, size); } \
+  static fn_status_t nrf_driver_##n##_send_packet_async(const void *tx_packet, size_t size) { return nrf_driver_send_packet_async(&nrf_drivers[n], tx_packet, size); } \
+  static fn_status_t nrf_driver_##n##_poll_tx(tx_status_t *tx_status) { return nrf_driver_poll_tx(&nrf_drivers[n], tx_status); } \
+  static fn_status_t nrf_driver_##n##_tx_callback(tx_callback_t callback, void *user_data) { return nrf_driver_tx_callback(&nrf_drivers[n], callback, user_data); } \
+  static fn_status_t nrf_driver_##n##_send_stream(const void *tx_packets, size_t size, size_t count, fn_status_irq_t *outcomes) { return nrf_driver_send_stream(&nrf_drivers[n], tx_packets, size, count, outcomes); } \
+  static fn_status_t nrf_driver_##n##_send_packet_noack(const void *tx_packet, size_t size) { return nrf_driver_send_packet_noack(&nrf_drivers[n], tx_packet, size); } \
+  static fn_status_t nrf_driver_##n##_send_stream_noack(const void *tx_packets, size_t size, size_t count) { return nrf_driver_send_stream_noack(&nrf_drivers[n], tx_packets, size, count); } \
+  static fn_status_t nrf_driver_##n##_beacon_start(const void *payload, size_t size, uint32_t interval_us) { return nrf_driver_beacon_start(&nrf_drivers[n], payload, size, interval_us); } \
+  static fn_status_t nrf_driver_##n##_beacon_update(const void *payload, size_t size) { return nrf_driver_beacon_update(&nrf_drivers[n], payload, size); } \
+  static fn_status_t nrf_driver_##n##_beacon_stop(void) { return nrf_driver_beacon_stop(&nrf_drivers[n]); } \
+  static fn_status_t nrf_driver_##n##_duty_cycle_start(uint32_t period_us, uint32_t listen_us) { return nrf_driver_duty_cycle_start(&nrf_drivers[n], period_us, listen_us); } \
+  static fn_status_t nrf_driver_##n##_duty_cycle_stop(void) { return nrf_driver_duty_cycle_stop(&nrf_drivers[n]); } \
+  static fn_status_t nrf_driver_##n##_read_packet(void *rx_packet, size_t size) { return nrf_driver_read_packet(&nrf_drivers[n], rx_packet, size); } \
+  static fn_status_t nrf_driver_##n##_is_packet(uint8_t *rx_p_no) { return nrf_driver_is_packet(&nrf_drivers[n], rx_p_no); } \
+  static fn_status_t nrf_driver_##n##_poll_events(uint8_t *events, uint8_t *rx_p_no) { return nrf_driver_poll_events(&nrf_drivers[n], events, rx_p_no); } \
+  static fn_status_t nrf_driver_##n##_receive_batch(rx_packet_t *rx_packets, size_t max_packets, size_t *count) { return nrf_driver_receive_batch(&nrf_drivers[n], rx_packets, max_packets, count); } \
+  static fn_status_t nrf_driver_##n##_rx_ring(rx_packet_t *slots, size_t depth) { return nrf_driver_rx_ring(&nrf_drivers[n], slots, depth); } \
+  static fn_status_t nrf_driver_##n##_rx_ring_pop(rx_packet_t *rx_packet) { return nrf_driver_rx_ring_pop(&nrf_drivers[n], rx_packet); } \
+  static fn_status_t nrf_driver_##n##_rx_ring_stats(size_t *count, uint32_t *overflows) { return nrf_driver_rx_ring_stats(&nrf_drivers[n], count, overflows); } \
+  static fn_status_t nrf_driver_##n##_tx_queue(tx_entry_t *entries, tx_result_t *results, size_t depth) { return nrf_driver_tx_queue(&nrf_drivers[n], entries, results, depth); } \
+  static fn_status_queue_t nrf_driver_##n##_tx_enqueue(const void *tx_packet, size_t size, uint32_t *sequence) { return nrf_driver_tx_enqueue(&nrf_drivers[n], tx_packet, size, sequence); } \
+  static fn_status_t nrf_driver_##n##_tx_result(tx_result_t *result) { return nrf_driver_tx_result(&nrf_drivers[n], result); } \
+  static fn_status_t nrf_driver_##n##_engine_start(void) { return nrf_driver_engine_start(&nrf_drivers[n]); } \
+  static fn_status_t nrf_driver_##n##_engine_stop(void) { return nrf_driver_engine_stop(&nrf_drivers[n]); } \
+  static fn_status_t nrf_driver_##n##_standby_mode(void) { return nrf_driver_standby_mode(&nrf_drivers[n]); } \
+  static fn_status_t nrf_driver_##n##_receiver_mode(void) { return nrf_driver_receiver_mode(&nrf_drivers[n]); } \
+  static fn_status_t nrf_driver_##n##_csn_timing(uint32_t setup_ns, uint32_t hold_ns) { return nrf_driver_csn_timing(&nrf_drivers[n], setup_ns, hold_ns); } \
+  static fn_status_t nrf_driver_##n##_ce_pulse(uint32_t width_us) { return nrf_driver_ce_pulse(&nrf_drivers[n], width_us); } \
+  static fn_status_t nrf_driver_##n##_close(void) { return nrf_driver_close(&nrf_drivers[n]); } \
+  static fn_status_t nrf_driver_##n##_sync_registers(void) { return nrf_driver_sync_registers(&nrf_drivers[n]); } \
+  static fn_status_t nrf_driver_##n##_get_config(nrf_manager_t *user_config) { return nrf_driver_get_config(&nrf_drivers[n], user_config); } \
+  static fn_status_t nrf_driver_##n##_last_status(uint8_t *status_reg) { return nrf_driver_last_status(&nrf_drivers[n], status_reg); } \
+  \
+  static void nrf_driver_##n##_irq_handler(void) { irq_handler(&nrf_drivers[n]); } \
+  \
+  static void nrf_driver_bind_##n(nrf_client_t *client) { \
+    nrf_drivers[n].irq_handler = nrf_driver_##n##_irq_handler; \
+    client->driver = &nrf_drivers[n]; \
+    client->configure = nrf_driver_##n##_configure; \
+    client->configure_pio = nrf_driver_##n##_configure_pio; \
+    client->initialise = nrf_driver_##n##_initialise; \
+    client->rx_destination = nrf_driver_##n##_rx_destination; \
+    client->tx_destination = nrf_driver_##n##_tx_destination; \
+    client->payload_size = nrf_driver_##n##_payload_size; \
+    client->dyn_payloads_enable = nrf_driver_##n##_dyn_payloads_enable; \
+    client->dyn_payloads_disable = nrf_driver_##n##_dyn_payloads_disable; \
+    client->ack_payloads_enable = nrf_driver_##n##_ack_payloads_enable; \
+    client->ack_payloads_disable = nrf_driver_##n##_ack_payloads_disable; \
+    client->ack_payload = nrf_driver_##n##_ack_payload; \
+    client->auto_retransmission = nrf_driver_##n##_auto_retransmission; \
+    client->rf_channel = nrf_driver_##n##_rf_channel; \
+    client->rf_data_rate = nrf_driver_##n##_rf_data_rate; \
+    client->rf_power = nrf_driver_##n##_rf_power; \
+    client->send_packet = nrf_driver_##n##_send_packet; \
+    client->send_packet_async = nrf_driver_##n##_send_packet_async; \
+    client->poll_tx = nrf_driver_##n##_poll_tx; \
+    client->tx_callback = nrf_driver_##n##_tx_callback; \
+    client->send_stream = nrf_driver_##n##_send_stream; \
+    client->send_packet_noack = nrf_driver_##n##_send_packet_noack; \
+    client->send_stream_noack = nrf_driver_##n##_send_stream_noack; \
+    client->beacon_start = nrf_driver_##n##_beacon_start; \
+    client->beacon_update = nrf_driver_##n##_beacon_update; \
+    client->beacon_stop = nrf_driver_##n##_beacon_stop; \
+    client->duty_cycle_start = nrf_driver_##n##_duty_cycle_start; \
+    client->duty_cycle_stop = nrf_driver_##n##_duty_cycle_stop; \
+    client->read_packet = nrf_driver_##n##_read_packet; \
+    client->is_packet = nrf_driver_##n##_is_packet; \
+    client->poll_events = nrf_driver_##n##_poll_events; \
+    client->receive_batch = nrf_driver_##n##_receive_batch; \
+    client->rx_ring = nrf_driver_##n##_rx_ring; \
+    client->rx_ring_pop = nrf_driver_##n##_rx_ring_pop; \
+    client->rx_ring_stats = nrf_driver_##n##_rx_ring_stats; \
+    client->tx_queue = nrf_driver_##n##_tx_queue; \
+    client->tx_enqueue = nrf_driver_##n##_tx_enqueue; \
+    client->tx_result = nrf_driver_##n##_tx_result; \
+    client->engine_start = nrf_driver_##n##_engine_start; \
+    client->engine_stop = nrf_driver_##n##_engine_stop; \
+    client->standby_mode = nrf_driver_##n##_standby_mode; \
+    client->receiver_mode = nrf_driver_##n##_receiver_mode; \
+    client->csn_timing = nrf_driver_##n##_csn_timing; \
+    client->ce_pulse = nrf_driver_##n##_ce_pulse; \
+    client->close = nrf_driver_##n##_close; \
+    client->sync_registers = nrf_driver_##n##_sync_registers; \
+    client->get_config = nrf_driver_##n##_get_config; \
+    client->last_status = nrf_driver_##n##_last_status; \
+  }
+
+// one NRF_DRIVER_BIND for each of the NRF_DRIVER_MAX_INSTANCES
+NRF_DRIVER_BIND(0)
+NRF_DRIVER_BIND(1)
+
+// nrf_driver_bind_n functions, indexed by nrf_drivers index
+static void (*const nrf_driver_bind[NRF_DRIVER_MAX_INSTANCES])(nrf_client_t *client) = {
+  nrf_driver_bind_0,
+  nrf_driver_bind_1
+};
+
+
+/**
+ * Binds the nrf_client_t to the next free nrf_driver_t instance,
+ * which holds its own pins, SPI instance, configuration and mode.
+ * The nrf_client_t function pointers are assigned functions, which
+ * call the corresponding nrf_driver function with that instance, 
+ * providing access to these functions through the nrf_client_t 
+ * object. The instance is also held in the driver member, for the 
+ * nrf_driver functions declared in nrf24_driver.h.
+ * 
+ * @note The function returns ERROR, if all NRF_DRIVER_MAX_INSTANCES
+ * instances are bound. nrf_driver_destroy_client frees an instance.
+ * 
+ * @param client nrf_client_t struct
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_create_client(nrf_client_t *client) {
+
+  fn_status_t status = ERROR;
+
+  for (size_t i = 0; (i < NRF_DRIVER_MAX_INSTANCES) && (status == ERROR); i++)
+  {
+    nrf_driver_t *driver = &(nrf_drivers[i]);
+
+    if (!driver->is_bound)
+    {
+      // instance starts from the default configuration
+      *driver = nrf_driver_default;
+      driver->is_bound = true;
+
+      nrf_driver_bind[i](client);
+
+      status = NRF_MNGR_OK;
+    }
+  }
+
+  return status;
+}
+
+
+/**
+ * Closes the SPI session of the nrf_driver_t instance bound to 
+ * the nrf_client_t and frees the instance for another client.
+ * 
+ * @param client nrf_client_t struct
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_destroy_client(nrf_client_t *client) {
+
+  nrf_driver_t *driver = client->driver;
+
+  fn_status_t status = ((driver != NULL) && driver->is_bound) ? NRF_MNGR_OK : ERROR;
+
+  if (status == NRF_MNGR_OK)
+  {
+    close_spi_session(driver);
+
+    driver->is_bound = false;
+    client->driver = NULL;
+  }
+
+  return status;
+}
+
+
+/************************************
+ *     Static Utility Functions     *
+ ************************************/
+
+
+/**
+ * Validates user nrf_manager_t configuration.
+ * 
+ * @param reg register to write the buffer to
+ * @param buffer value to be held in the register
+ * @param size size of the buffer
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+static fn_status_t validate_config(nrf_manager_t *user_config) {
+
+  uint8_t valid_members = 0;
+
+  // validate address width
+  if ((user_config->address_width) >= AW_3_BYTES && (user_config->address_width <= AW_5_BYTES))
+  {
+    valid_members++;
+  }
+
+  // validate RF Channel
+  if ((user_config->channel >= 2) && (user_config->channel <= 125))
+  {
+    valid_members++;
+  }
+
+  // validate RF data rate
+  switch (user_config->data_rate)
+  {
+    case RF_DR_1MBPS:
+      valid_members++;
+    break;
+
+    case RF_DR_2MBPS:
+      valid_members++;
+    break;
+
+    case RF_DR_250KBPS:
+      valid_members++;
+    break;
+    
+    default:
+    break;
+  }
+
+  // validate dynamic payloads setting
+  if ((user_config->dyn_payloads == DYNPD_ENABLE) || (user_config->dyn_payloads == DYNPD_DISABLE))
+  {
+    valid_members++;
+  }
+
+  // validate RF power setting
+  for (size_t rf_pow = RF_PWR_NEG_18DBM; rf_pow <= RF_PWR_0DBM; rf_pow += 2)
+  {
+    if (user_config->power == rf_pow) { valid_members++; }
+  }
+
+  // validate retransmission count
+  if (user_config->retr_count <= ARC_15RT)
+  {
+    valid_members++;
+  }
+
+  // validate retransmission delay
+  for (size_t delay = ARD_250US; delay <= ARD_1000US; delay += 16)
+  {
+    if (user_config->retr_delay == delay) { valid_members++; }
+  }
+
+  fn_status_t status = (valid_members == 7) ? NRF_MNGR_OK : ERROR;
+
+  return status;
+} 
+
+
+
+/**
+ * Writes the buffer value to the specified register.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param reg register to write the buffer to
+ * @param buffer value to be held in the register
+ * @param size size of the buffer
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+static fn_status_t w_register(nrf_driver_t *driver, register_map_t reg, const void *buffer, size_t size) {
+
+  // ensure 3 MSB are [001] (write to the register)
+  reg = ((REGISTER_MASK & reg) | W_REGISTER);
+
+  // register address, followed by buffer streamed without a copy
+  fn_status_t status = spi_write_command(driver, reg, buffer, size, NULL);
+
+  return status; // return error flag value
+}
+
+
+/**
+ * Writes the value to the specified single byte register
+ * and stores it in the register shadow, if the write was 
+ * successful.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param reg register held in the shadow
+ * @param value value to be held in the register
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+static fn_status_t w_shadow_register(nrf_driver_t *driver, register_map_t reg, uint8_t value) {
+
+  fn_status_t status = w_register(driver, reg, &value, ONE_BYTE);
+
+  if (status == SPI_MNGR_OK) { driver->shadow[reg] = value; }
+
+  return status;
+}
+
+
+/**
+ * Reads one byte from the specified register.
+ *  
+ * @param driver nrf_driver_t instance
+ * @param reg register address
+ * 
+ * @return register value 
+ */
+static uint8_t r_register_byte(nrf_driver_t *driver, register_map_t reg) {
+
+  /**
+   * NRF24L01 returns the STATUS register value,
+   * hence why tx_buffer and rx_buffer are two
+   * bytes. The first index of rx_buffer will
+   * hold the STATUS register value. The second
+   * index will hold the value of the specified
+   * register.
+   */
+  uint8_t tx_buffer[TWO_BYTES] = { reg, NOP };
+  uint8_t rx_buffer[TWO_BYTES] = { 0, 0 };
+
+  spi_transfer(driver, tx_buffer, rx_buffer, TWO_BYTES);
+
+  // *(rx_buffer + 0) holds STATUS register value
+  return *(rx_buffer + 1);
+}
+
+
+/**
+ * Reads a number of bytes from the specified register.
+ * 
+ * NOTE: Works the same as r_register_byte function. 
+ * Some registers hold more than one byte, such as
+ * RX_ADDR_P0 - RX_ADDR_P5 registers (5 bytes). An
+ * array buffer is used to store the register value.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param reg register address
+ * @param buffer buffer for register value
+ * @param buffer_size size of buffer
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+static fn_status_t r_register_bytes(nrf_driver_t *driver, register_map_t reg, uint8_t *buffer, size_t buffer_size) {
+
+  /**
+   * NRF24L01 returns the STATUS register value, hence why tx_buffer 
+   * and rx_buffer are the size of buffer_size + 1. The first index 
+   * of rx_buffer will hold the STATUS register  value. The remainder 
+   * will hold the value of the specified register.
+   */
+  size_t total_size = buffer_size + 1;
+
+  uint8_t tx_buffer[total_size];
+  uint8_t rx_buffer[total_size];
+
+  // store register address in tx_buffer[0]
+  *(tx_buffer + 0) = reg;
+
+  // fill rest of tx_buffer with NOP
+  for (size_t i = 1; i < total_size; i++) { *(tx_buffer + i) = NOP; }
+
+  fn_status_t status = spi_transfer(driver, tx_buffer, rx_buffer, total_size);
+  
+  // skip rx_buffer[0] (STATUS value) and transfer remaining values to buffer
+  for (size_t i = 1; i < total_size; i++) { *(buffer++) = *(rx_buffer + i); }
+
+  return status;
+}
+
+
+/**
+ * Reads the STATUS register, clocked in with a NOP command.
+ * 
+ * @param driver nrf_driver_t instance
+ * 
+ * @return STATUS register value
+ */
+static uint8_t r_status(nrf_driver_t *driver) {
+
+  uint8_t tx_buffer[ONE_BYTE] = { NOP };
+  uint8_t rx_buffer[ONE_BYTE] = { 0 };
+
+  spi_transfer(driver, tx_buffer, rx_buffer, ONE_BYTE);
+
+  return rx_buffer[0];
+}
+
+
+/**
+ * Writes FLUSH_RX instruction over SPI to NRF24L01,
+ * which will flush the RX FIFO.
+ * 
+ * @param driver nrf_driver_t instance
+ */
+static void flush_rx_fifo(nrf_driver_t *driver) {
+  
+  uint8_t tx_buffer[ONE_BYTE] = { FLUSH_RX };
+  uint8_t rx_buffer[ONE_BYTE];
+
+  spi_transfer(driver, tx_buffer, rx_buffer, ONE_BYTE);
+
+  return;
+}
+
+
+/**
+ * Checks the STATUS register RX_DR, TX_DS and MAX_RT bits and 
+ * resets every asserted bit with one combined W_REGISTER STATUS
+ * write, batched with a FLUSH_TX command if MAX_RT is asserted. 
+ * Reset bits are held as events in the instance, until consumed
+ * (see consume_events), so an event is not lost to a caller 
+ * interested in another.
+ * 
+ * The STATUS value tracked from the last command is used, 
+ * without a read, if it shows TX_DS or MAX_RT asserted, or 
+ * RX_DR asserted with a data pipe number. Otherwise STATUS 
+ * is clocked in with a NOP command.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param rx_p_no data pipe number (7 if RX FIFO empty) or NULL
+ * 
+ * @return held events and TX_FULL_EVENT, as a bitmask of fn_status_event_t
+ */
+static uint8_t check_status_events(nrf_driver_t *driver, uint8_t *rx_p_no) {
+
+  // tracked STATUS register value and data pipe number
+  uint8_t status = driver->status_reg;
+  uint8_t tracked_p_no = (status >> STATUS_RX_P_NO) & STATUS_RX_P_NO_MASK;
+
+  bool is_tx_tracked = status & (TX_DS_EVENT | MAX_RT_EVENT);
+  bool is_rx_tracked = (status & RX_DR_EVENT) && (tracked_p_no < ALL_DATA_PIPES);
+
+  // value of STATUS register
+  if (!is_tx_tracked && !is_rx_tracked) { status = r_status(driver); }
+
+  // RX_DR, TX_DS and MAX_RT bits, each reset by writing 1
+  uint8_t asserted = status & STATUS_INTERRUPT_MASK;
+
+  if (asserted)
+  {
+    // STATUS register values clocked in by the reset commands, for track_status
+    uint8_t reset_status[2][TWO_BYTES];
+
+    // combined reset command and FLUSH_TX command, sent in one batch
+    spi_manager_frame_t frames[2] = {
+      { .tx_buffer = (uint8_t[]){ (REGISTER_MASK & STATUS) | W_REGISTER, asserted }, .rx_buffer = reset_status[0], .len = TWO_BYTES },
+      { .tx_buffer = (uint8_t[]){ FLUSH_TX }, .rx_buffer = reset_status[1], .len = ONE_BYTE }
+    };
+
+    // flush the packet that reached max retransmissions from TX FIFO
+    if (spi_transfer_batch(driver, frames, (asserted & MAX_RT_EVENT) ? 2 : 1) == SPI_MNGR_OK)
+    {
+      driver->events |= asserted;
+    }
+  }
+
+  if (rx_p_no != NULL) { *rx_p_no = (status >> STATUS_RX_P_NO) & STATUS_RX_P_NO_MASK; }
+
+  return driver->events | (status & TX_FULL_EVENT);
+}
+
+
+/**
+ * Checks the STATUS register IRQ bits through check_status_events,
+ * only if the NRF24L01 has signalled an interrupt on the IRQ pin,
+ * or the tracked STATUS value already shows an IRQ bit asserted.
+ * Without an IRQ pin, the STATUS register is read on every call.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param rx_p_no data pipe number (7 if RX FIFO empty or not read) or NULL
+ * 
+ * @return held events, as a bitmask of fn_status_event_t
+ */
+static uint8_t poll_status_events(nrf_driver_t *driver, uint8_t *rx_p_no) {
+
+  uint8_t events = driver->events;
+
+  if (rx_p_no != NULL) { *rx_p_no = STATUS_RX_P_NO_MASK; }
+
+  if ((driver->irq_pin == IRQ_PIN_UNUSED) || driver->is_irq_pending || (driver->status_reg & STATUS_INTERRUPT_MASK))
+  {
+    // cleared before STATUS is read, so a later interrupt is latched again
+    driver->is_irq_pending = false;
+
+    events = check_status_events(driver, rx_p_no);
+
+    /**
+     * an IRQ bit asserted after STATUS was read holds the IRQ pin 
+     * LOW, without a further falling edge, so is latched here
+     */
+    if ((driver->irq_pin != IRQ_PIN_UNUSED) && irq_is_low(driver->irq_pin)) { driver->is_irq_pending = true; }
+  }
+
+  return events;
+}
+
+
+/**
+ * Removes the specified events from those held in the instance, 
+ * returning those which were held.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param events bitmask of fn_status_event_t
+ * 
+ * @return events consumed, as a bitmask of fn_status_event_t
+ */
+static uint8_t consume_events(nrf_driver_t *driver, uint8_t events) {
+
+  uint8_t consumed = driver->events & events;
+
+  driver->events &= ~consumed;
+
+  return consumed;
+}
+
+
+/**
+ * Checks for the outcome of a packet awaiting TX_DS or MAX_RT. 
+ * Once either event is held, it is consumed and the OBSERVE_TX 
+ * register is read into tx_status (if not NULL), along with an 
+ * RX_DR event held with TX_DS, indicating an ACK payload.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param tx_status outcome of the packet or NULL
+ * 
+ * @return NONE_ASSERTED (0), TX_DS_ASSERTED (2), MAX_RT_ASSERTED (3)
+ */
+static fn_status_irq_t complete_tx(nrf_driver_t *driver, tx_status_t *tx_status) {
+
+  fn_status_irq_t status_irq = NONE_ASSERTED;
+
+  if (driver->is_tx_pending)
+  {
+    // RX_DR does not complete a transmission and is left held
+    poll_status_events(driver, NULL);
+
+    uint8_t events = consume_events(driver, TX_DS_EVENT | MAX_RT_EVENT);
+
+    if (events & MAX_RT_EVENT) { status_irq = MAX_RT_ASSERTED; }
+    else if (events & TX_DS_EVENT) { status_irq = TX_DS_ASSERTED; }
+
+    if (status_irq != NONE_ASSERTED)
+    {
+      driver->is_tx_pending = false;
+
+      if (tx_status != NULL)
+      {
+        uint8_t observe_tx = r_register_byte(driver, OBSERVE_TX);
+
+        tx_status->irq = status_irq;
+        tx_status->retransmits = (observe_tx >> OBSERVE_TX_ARC_CNT) & OBSERVE_TX_CNT_MASK;
+        tx_status->lost = (observe_tx >> OBSERVE_TX_PLOS_CNT) & OBSERVE_TX_CNT_MASK;
+
+        // RX_DR is left held for nrf_driver_is_packet, as an ACK payload is read as a packet
+        tx_status->is_ack_payload = (status_irq == TX_DS_ASSERTED) && (driver->events & RX_DR_EVENT);
+      }
+    }
+  }
+
+  return status_irq;
+}
+
+
+/**
+ * Completes payloads in flight in the TX FIFO (oldest first), for
+ * nrf_driver_send_stream and the TX queue. Completions are counted
+ * from the occupancy of the TX FIFO and not from TX_DS, which is
+ * asserted once for any number of payloads completed before it is
+ * reset. TX_DS and MAX_RT are reset before FIFO_STATUS is read, so
+ * a payload completed after the read asserts TX_DS again.
+ * 
+ * FIFO_STATUS only reports an empty or a full TX FIFO, so whilst 
+ * transmitting, one or two payloads left are counted as two and 
+ * the remainder is completed by a later event. On MAX_RT, CE is 
+ * driven LOW before MAX_RT is reset, so the NRF24L01 does not 
+ * transmit again whilst the batch reads the TX FIFO, which is then
+ * flushed. One or two payloads left are then told apart from the 
+ * payloads in flight, as TX_DS asserted with MAX_RT completed the
+ * one payload ahead of the payload which reached MAX_RT.
+ * 
+ * @note CE is left LOW after MAX_RT, for the caller to drive HIGH
+ * again, once the flushed payloads are uploaded again. A payload 
+ * whose TX_DS was reset with a previous payload's TX_DS (counted
+ * by a later event) is reported as MAX_RT_ASSERTED, if the next 
+ * payload then reaches MAX_RT.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param in_flight payloads uploaded, without an outcome (up to 3)
+ * @param outcomes outcome of each completed payload (3 entries)
+ * 
+ * @return payloads completed. If the last outcome is MAX_RT_ASSERTED, 
+ * the payloads queued behind it were flushed from the TX FIFO
+ */
+static size_t complete_tx_fifo(nrf_driver_t *driver, size_t in_flight, fn_status_irq_t *outcomes) {
+
+  // tracked STATUS register value, read if it shows no transmission outcome
+  uint8_t status = driver->status_reg;
+
+  if (!(status & (TX_DS_EVENT | MAX_RT_EVENT))) { status = r_status(driver); }
+
+  // RX_DR, TX_DS and MAX_RT bits, each reset by writing 1 (RX_DR is held as an event)
+  uint8_t asserted = status & STATUS_INTERRUPT_MASK;
+
+  // TX_DS or MAX_RT, asserted or held from check_status_events
+  uint8_t tx_events = (asserted | driver->events) & (TX_DS_EVENT | MAX_RT_EVENT);
+
+  size_t completed = 0;
+
+  if (tx_events && (in_flight > 0))
+  {
+    bool is_max_rt = (tx_events & MAX_RT_EVENT) != 0;
+
+    // the NRF24L01 transmits again if MAX_RT is reset with CE HIGH
+    if (is_max_rt) { ce_put_low(driver->user_pins.ce); }
+
+    // R_REGISTER FIFO_STATUS response
+    uint8_t fifo_status[TWO_BYTES] = { 0, 0 };
+
+    spi_manager_frame_t frames[3] = {
+      { .tx_buffer = (uint8_t[]){ (REGISTER_MASK & STATUS) | W_REGISTER, asserted }, .rx_buffer = NULL, .len = TWO_BYTES },
+      { .tx_buffer = (uint8_t[]){ FIFO_STATUS, NOP }, .rx_buffer = fifo_status, .len = TWO_BYTES },
+      { .tx_buffer = (uint8_t[]){ FLUSH_TX }, .rx_buffer = NULL, .len = ONE_BYTE }
+    };
+
+    if (spi_transfer_batch(driver, frames, is_max_rt ? 3 : 2) == SPI_MNGR_OK)
+    {
+      driver->events |= asserted;
+
+      consume_events(driver, TX_DS_EVENT | MAX_RT_EVENT);
+
+      uint8_t fifo = fifo_status[1];
+
+      // payloads still queued in the TX FIFO
+      size_t queued = 2;
+
+      if ((fifo >> FIFO_STATUS_TX_EMPTY) & SET_BIT) { queued = 0; }
+      else if ((fifo >> FIFO_STATUS_TX_FULL) & SET_BIT) { queued = 3; }
+      else if (is_max_rt)
+      {
+        // one or two payloads left, as TX_DS asserted with MAX_RT completed the one payload ahead
+        queued = in_flight - ((tx_events & TX_DS_EVENT) ? 1 : 0);
+
+        if (queued > 2) { queued = 2; }
+        if (queued < 1) { queued = 1; }
+      }
+
+      if (queued > in_flight) { queued = in_flight; }
+
+      // payloads ahead of those queued were acknowledged
+      for (; completed < (in_flight - queued); completed++) { outcomes[completed] = TX_DS_ASSERTED; }
+
+      // the payload at the front of the TX FIFO reached MAX_RT
+      if (is_max_rt && (queued > 0)) { outcomes[completed++] = MAX_RT_ASSERTED; }
+    }
+  }
+
+  return completed;
+}
+
+
+/**
+ * Enables the falling edge interrupt on the IRQ pin in user_pins, 
+ * if there is one. The interrupt is latched as pending initially, 
+ * so IRQ bits asserted before the interrupt was enabled are read.
+ * 
+ * @param driver nrf_driver_t instance
+ * 
+ * @return PIN_MNGR_OK (1), ERROR (0)
+ */
+static fn_status_t configure_irq(nrf_driver_t *driver) {
+
+  pin_manager_t *pins = &(driver->user_pins);
+
+  fn_status_t status = PIN_MNGR_OK;
+
+  if (pins->is_irq)
+  {
+    uint8_t other_pins[5] = { pins->copi, pins->cipo, pins->sck, pins->csn, pins->ce };
+
+    // IRQ pin must not be used for any other pin
+    for (size_t i = 0; i < 5; i++)
+    {
+      if (pins->irq == other_pins[i]) { status = ERROR; }
+    }
+
+    if (status == PIN_MNGR_OK)
+    {
+      // irq_pin is read by irq_handler, so is set before the interrupt is enabled
+      driver->irq_pin = pins->irq;
+      driver->is_irq_pending = true;
+
+      status = pin_manager_configure_irq(pins->irq, driver->irq_handler);
+
+      if (status != PIN_MNGR_OK) { driver->irq_pin = IRQ_PIN_UNUSED; }
+    }
+  }
+
+  return status;
+}
+
+
+/**
+ * Raw GPIO IRQ handler for the IRQ pin of an instance, which 
+ * latches the interrupt as pending, for poll_status_events, and 
+ * wakes a core waiting in nrf_driver_send_packet. In RX Mode, 
+ * with the RX ring enabled, the RX FIFO is drained into the RX 
+ * ring and otherwise, with the TX queue enabled, the TX queue is
+ * pumped, unless the interrupt preempted an SPI transfer on the 
+ * same SPI bus (by any driver instance sharing it), which leaves 
+ * it latched for nrf_driver_rx_ring_pop or nrf_driver_tx_result.
+ * 
+ * @param driver nrf_driver_t instance
+ */
+static void irq_handler(nrf_driver_t *driver) {
+
+  pin_manager_irq_acknowledge(driver->irq_pin);
+
+  driver->is_irq_pending = true;
+
+  // SPI bus is free, as no driver instance on it was interrupted mid-transfer
+  if (!is_spi_held(driver))
+  {
+    if ((driver->rx_ring != NULL) && (driver->mode == RX_MODE)) { drain_rx_ring(driver); }
+
+    if ((driver->tx_queue != NULL) && (driver->mode != RX_MODE))
+    {
+      // a flag asserted during the pump holds the IRQ pin LOW, without a further falling edge
+      do { pump_tx_queue(driver); } while (driver->is_irq_pending && (driver->tx_queue_tail != driver->tx_queue_upload));
+    }
+  }
+
+  __sev();
+
+  return;
+}
+
+
+/**
+ * Drains the RX FIFO into the RX ring, through receive_batch, 
+ * reading packets directly into the free slots after the head. 
+ * Once the RX ring is full, packets are still read from the RX 
+ * FIFO, to free it, but are discarded and counted as overflows.
+ * 
+ * @note The only producer of the RX ring, called from irq_handler
+ * or, with the SPI bus held, from nrf_driver_rx_ring_pop.
+ * 
+ * @param driver nrf_driver_t instance
+ */
+static void drain_rx_ring(nrf_driver_t *driver) {
+
+  rx_packet_t *ring = driver->rx_ring;
+
+  // packets read whilst the RX ring is full
+  rx_packet_t discard[3];
+
+  size_t requested = 0;
+  size_t count = 0;
+
+  do {
+
+    uint32_t head = driver->rx_ring_head;
+
+    size_t used = head - driver->rx_ring_tail;
+    size_t index = head & (driver->rx_ring_depth - 1);
+
+    // free slots up to the end of the slots array, as receive_batch fills contiguously
+    requested = driver->rx_ring_depth - used;
+    if (requested > (driver->rx_ring_depth - index)) { requested = driver->rx_ring_depth - index; }
+
+    if (requested > 0)
+    {
+      nrf_driver_receive_batch(driver, &ring[index], requested, &count);
+
+      // slots written before the head is published to the consumer
+      __dmb();
+
+      driver->rx_ring_head = head + count;
+
+    } else {
+
+      requested = 3;
+
+      nrf_driver_receive_batch(driver, discard, requested, &count);
+
+      driver->rx_ring_overflows += count;
+    }
+
+  // receive_batch stops short of requested, once the RX FIFO is empty
+  } while (count == requested);
+
+  return;
+}
+
+
+/**
+ * Completes the TX queue entries in flight, from the occupancy of
+ * the TX FIFO (see complete_tx_fifo), storing their outcomes in the
+ * TX results (if enabled), then tops the TX FIFO up from the TX 
+ * queue, up to three payloads. CE is held HIGH (Standby-II and TX
+ * Mode), whilst payloads are in flight, as in nrf_driver_send_stream.
+ * 
+ * A payload reaching MAX_RT is flushed from the TX FIFO, by
+ * complete_tx_fifo, with the payloads queued behind it, which
+ * are then uploaded again.
+ * 
+ * @note The only consumer of the TX queue, called from irq_handler
+ * or, with the SPI bus held, from nrf_driver_tx_enqueue and 
+ * nrf_driver_tx_result.
+ * 
+ * @param driver nrf_driver_t instance
+ */
+static void pump_tx_queue(nrf_driver_t *driver) {
+
+  tx_entry_t *queue = driver->tx_queue;
+
+  uint32_t mask = driver->tx_queue_depth - 1;
+  uint32_t tail = driver->tx_queue_tail;
+  uint32_t upload = driver->tx_queue_upload;
+
+  // outcome of each completed entry, in sequence order
+  fn_status_irq_t outcomes[3];
+  size_t completed = 0;
+
+  if (tail != upload)
+  {
+    // driver->is_irq_pending cleared before STATUS is read, so a later interrupt is latched again
+    driver->is_irq_pending = false;
+
+    completed = complete_tx_fifo(driver, upload - tail, outcomes);
+
+    // upload the payloads flushed behind the one which reached MAX_RT again
+    if ((completed > 0) && (outcomes[completed - 1] == MAX_RT_ASSERTED)) { upload = tail + completed; }
+  }
+
+  for (size_t i = 0; i < completed; i++, tail++)
+  {
+    tx_result_t *results = driver->tx_results;
+    uint32_t results_head = driver->tx_results_head;
+
+    // a result is dropped, if the TX results are full
+    if ((results != NULL) && ((results_head - driver->tx_results_tail) < driver->tx_queue_depth))
+    {
+      results[results_head & mask] = (tx_result_t){ .sequence = tail, .irq = outcomes[i] };
+
+      // result written before the head is published to the consumer
+      __dmb();
+
+      driver->tx_results_head = results_head + 1;
+    }
+  }
+
+  // TX_DS or MAX_RT held from before the first payload is not an outcome
+  if (tail == upload) { consume_events(driver, TX_DS_EVENT | MAX_RT_EVENT); }
+
+  // STATUS register value, clocked in before each payload
+  uint8_t upload_status = 0;
+
+  // top up the TX FIFO, up to three payloads, until TX_FULL
+  while ((upload != driver->tx_queue_head) && ((upload - tail) < 3))
+  {
+    // entry read after the head was published by the producer
+    __dmb();
+
+    tx_entry_t *entry = &queue[upload & mask];
+
+    if (spi_write_command(driver, W_TX_PAYLOAD, entry->payload, entry->width, &upload_status) != SPI_MNGR_OK) { break; }
+
+    // a payload written whilst TX_FULL was set is discarded by the NRF24L01
+    if ((upload_status >> STATUS_TX_FULL) & SET_BIT) { break; }
+
+    upload++;
+  }
+
+  driver->tx_queue_upload = upload;
+
+  // entries read before they are released to the producer
+  __dmb();
+
+  driver->tx_queue_tail = tail;
+
+  if (tail != upload)
+  {
+    // CE is held HIGH, so each payload is transmitted once uploaded
+    cancel_ce_pulse(driver);
+    ce_put_high(driver->user_pins.ce);
+
+    driver->mode = TX_MODE;
+
+  } else if (driver->mode != STANDBY_I) {
+
+    // Drive CE LOW, NRF24L01+ enters Standby-I mode
+    ce_put_low(driver->user_pins.ce);
+
+    driver->mode = STANDBY_I;
+  }
+
+  // a flag asserted after STATUS was read holds the IRQ pin LOW
+  if ((driver->irq_pin != IRQ_PIN_UNUSED) && irq_is_low(driver->irq_pin)) { driver->is_irq_pending = true; }
+
+  return;
+}
+
+
+/**
+ * Radio engine, run on core 1 by nrf_driver_engine_start. Each pass
+ * pumps the TX queue, switching the NRF24L01 out of RX Mode whilst
+ * there are queued packets, or else drains the RX FIFO into the RX 
+ * ring in RX Mode. The IRQ pin level is read in place of the IRQ 
+ * pin interrupt. A pass which leaves nothing pending is followed 
+ * by an ENGINE_POLL_US wait, so the SPI bus is not used whilst idle
+ * and, without an IRQ pin, STATUS is read once each wait.
+ */
+static void engine_main(void) {
+
+  nrf_driver_t *driver = engine_driver;
+
+  while (driver->is_engine)
+  {
+    // an asserted IRQ bit holds the IRQ pin LOW
+    if ((driver->irq_pin != IRQ_PIN_UNUSED) && irq_is_low(driver->irq_pin)) { driver->is_irq_pending = true; }
+
+    bool is_tx = (driver->tx_queue != NULL) && (driver->tx_queue_head != driver->tx_queue_tail);
+
+    if (is_tx)
+    {
+      if (driver->mode == RX_MODE) { nrf_driver_standby_mode(driver); }
+
+      // a free TX FIFO slot for a queued packet, or an outcome to read
+      bool is_upload = (driver->tx_queue_upload != driver->tx_queue_head) && ((driver->tx_queue_upload - driver->tx_queue_tail) < 3);
+
+      if (driver->is_irq_pending || is_upload) { pump_tx_queue(driver); }
+
+    } else if (driver->rx_ring != NULL) {
+
+      if (driver->mode != RX_MODE) { nrf_driver_receiver_mode(driver); }
+
+      if (driver->is_irq_pending) { drain_rx_ring(driver); }
+    }
+
+    if (!driver->is_irq_pending)
+    {
+      // the SPI bus is left free, until the next poll
+      busy_wait_us_32(ENGINE_POLL_US);
+
+      // without an IRQ pin, STATUS is read on the next pass
+      if (driver->irq_pin == IRQ_PIN_UNUSED) { driver->is_irq_pending = true; }
+    }
+  }
+
+  driver->is_engine_running = false;
+
+  return;
+}
+
+
+/**
+ * Indicates if the instance is free to transmit, with no packet 
+ * sent by nrf_driver_send_packet_async awaiting its outcome, no
+ * packet in the TX queue and no beacon.
+ * 
+ * @param driver nrf_driver_t instance
+ * 
+ * @return true if free to transmit
+ */
+static bool is_tx_idle(nrf_driver_t *driver) {
+
+  return !driver->is_tx_pending && (driver->tx_queue_head == driver->tx_queue_tail) && !driver->is_beacon && !driver->is_duty_cycle;
+}
+
+
+/**
+ * Repeating timer callback, called from the alarm interrupt, 
+ * which starts a CE pulse, so the NRF24L01 retransmits the beacon 
+ * payload. No SPI transfer is made, so the callback does not
+ * conflict with a transfer it preempted.
+ * 
+ * @param timer repeating timer, with the nrf_driver_t instance as user_data
+ * 
+ * @return true, to keep repeating
+ */
+static bool beacon_callback(repeating_timer_t *timer) {
+
+  nrf_driver_t *driver = (nrf_driver_t *)timer->user_data;
+
+  if (!driver->is_beacon_update)
   {
-    // cast void *rx_packet to uint8_t pointer
-    uint8_t *rx_packet_ptr = (uint8_t *)rx_packet;
+    // pulse CE high to transmit, ended by a further alarm
+    pulse_ce(driver);
 
-    // W_TX_PAYLOAD command + packet_size
-    size_t total_size = size + 1;
+    driver->beacon_pulse_us = time_us_32();
+  }
+
+  return true;
+}
+
+
+/**
+ * Waits until a beacon transmission, started by the last CE 
+ * pulse, has completed (see BEACON_AIRTIME_US).
+ * 
+ * @param driver nrf_driver_t instance
+ */
+static void wait_beacon_airtime(nrf_driver_t *driver) {
 
-    uint8_t tx_buffer[total_size]; // SPI transfer TX buffer
-    uint8_t rx_buffer[total_size]; // SPI transfer RX buffer
+  while ((time_us_32() - driver->beacon_pulse_us) < BEACON_AIRTIME_US) { tight_loop_contents(); }
+
+  return;
+}
+
+
+/**
+ * Alarm callback, called from the alarm interrupt once the RX 
+ * Mode settling time has completed, which latches RX_READY_EVENT
+ * for nrf_driver_poll_events and wakes a waiting core.
+ * 
+ * @param id alarm ID
+ * @param user_data nrf_driver_t instance
+ * 
+ * @return 0, so the alarm does not repeat
+ */
+static int64_t rx_settle_callback(alarm_id_t id, void *user_data) {
 
-    // put R_RX_PAYLOAD command into first index of tx_buffer
-    tx_buffer[0] = R_RX_PAYLOAD;
+  nrf_driver_t *driver = (nrf_driver_t *)user_data;
 
-    // store byte(s) in tx_packet (tx_packet_ptr) into tx_buffer[]
-    for (size_t i = 1; i < total_size; i++) { *(tx_buffer + i) = NOP; }
-    
-    csn_put_low(nrf_driver.user_pins.csn); // drive CSN pin LOW
-    status = spi_manager_transfer(spi->instance, tx_buffer, rx_buffer, total_size);
-    csn_put_high(nrf_driver.user_pins.csn); // drive CSN pin HIGH
-    
-    // skip rx_buffer[0] (STATUS value) and transfer remaining values to buffer
-    for (size_t i = 0; i < size; i++)
-    { 
-      *(rx_packet_ptr + i) = rx_buffer[i + 1]; 
-    }
-  }
+  driver->rx_settle_alarm = 0;
+  driver->is_rx_ready = true;
 
-  // deinitialise SPI at function end
-  spi_manager_deinit_spi(spi->instance);
+  __sev();
 
-  return status;
+  return 0;
 }
 
 
 /**
- * Polls the STATUS register to ascertain if there is a packet 
- * in the RX FIFO. The function will return PASS (1) if there 
- * is a packet available to read, or FAIL (0) if not. 
+ * Cancels an RX Mode settling time alarm, which has not yet 
+ * completed, as RX Mode was left.
  * 
- * @return NRF_MNGR_OK (3), ERROR (0)
+ * @param driver nrf_driver_t instance
  */
-fn_status_t nrf_driver_is_packet(uint8_t *rx_p_no) {
+static void cancel_rx_settle(nrf_driver_t *driver) {
 
-  spi_manager_t *spi = &(nrf_driver.user_spi);
+  alarm_id_t alarm = driver->rx_settle_alarm;
 
-  spi_manager_init_spi(spi->instance, spi->baudrate);
-
-  /**
-   * check_status_irq function checks if uint8_t *rx_p_no
-   * argument is NULL. If not, the data pipe number the 
-   * packet was received on will be passed to rx_p_no
-   */
+  if (alarm > 0)
+  {
+    cancel_alarm(alarm);
 
-  // NONE_ASSERTED (0), RX_DR_ASSERTED (1), TX_DS_ASSERTED (2), MAX_RT_ASSERTED (3)
-  fn_status_t status = (check_status_irq(rx_p_no) == RX_DR_ASSERTED) ? NRF_MNGR_OK : ERROR;
+    driver->rx_settle_alarm = 0;
+  }
 
-  spi_manager_deinit_spi(spi->instance);
+  driver->is_rx_ready = false;
 
-  return status;
+  return;
 }
 
 
 /**
- * Puts the NRF24L01 into RX Mode. Sets the CONFIG register 
- * PRIM_RX bit value and drive CE pin HIGH.
+ * Drives CE HIGH and sets an alarm, which drives CE LOW after 
+ * ce_pulse_us, so a transmission is started without waiting for
+ * the pulse to end. If no alarm is free, or the radio engine is
+ * running, the pulse is waited for.
  * 
- * NOTE: State diagram in the datasheet (6.1.1) highlights
- * conditions for entering Rx and Tx operating modes. One 
- * condition is the value of PRIM_RX (bit 0) in the CONFIG
- * register. PRIM_RX = 1 for Rx mode or 0 for Tx mode. CE
- * pin is driven HIGH for Rx mode and is only driven high 
- * in Tx mode to facilitate the Tx of data (10us+).
+ * @note May be called from an alarm callback (see beacon_callback).
  * 
- * @return SPI_MNGR_OK (2), ERROR (0)
+ * @param driver nrf_driver_t instance
  */
-fn_status_t nrf_driver_receiver_mode(void) {
-  
-  spi_manager_t *spi = &(nrf_driver.user_spi);
-
-  spi_manager_init_spi(spi->instance, spi->baudrate);
-
-  // read CONFIG register value
-  uint8_t config = r_register_byte(CONFIG);
+static void pulse_ce(nrf_driver_t *driver) {
 
-  // is CONFIG register PRIM_RX bit set?
-  uint8_t prim_rx = (config >> CONFIG_PRIM_RX) & 1;
+  // a pulse in progress is restarted
+  cancel_ce_pulse(driver);
 
-  fn_status_t status = NRF_MNGR_OK;
-
-  // PRIM_RX bit should be set for RX Mode
-  if (prim_rx != SET_BIT)
-  {
-    // set PRIM_RX bit in CONFIG register
-    config |= (SET_BIT << CONFIG_PRIM_RX);
+  ce_put_high(driver->user_pins.ce);
 
-    // write set bit to CONFIG register
-    status = w_register(CONFIG, &config, ONE_BYTE);
-  }
+  // the radio engine takes no alarm interrupt on core 0, so it waits on core 1
+  alarm_id_t alarm = (!driver->is_engine) ? add_alarm_in_us(driver->ce_pulse_us, ce_pulse_callback, driver, true) : 0;
 
-  // restore the RX_ADDR_P0 address, if exists
-  if (nrf_driver.is_rx_addr_p0)
+  if (alarm > 0)
   {
-    w_register(RX_ADDR_P0, nrf_driver.rx_addr_p0, nrf_driver.address_width_bytes);
-  }
-
-  // Drive CE HIGH
-  ce_put_high(nrf_driver.user_pins.ce);
+    driver->ce_pulse_alarm = alarm;
 
-  // NRF24L01+ enters RX Mode after 130μS
-  sleep_us(130);
+  } else {
 
-  nrf_driver.mode = RX_MODE; // reflect RX Mode in nrf_status
+    busy_wait_us_32(driver->ce_pulse_us);
 
-  spi_manager_deinit_spi(spi->instance);
+    ce_put_low(driver->user_pins.ce);
+  }
 
-  return status;
+  return;
 }
 
 
 /**
- * Assign public nrf_driver function addresses to
- * the coressponding nrf_client_t function pointers,
- * providing access to these functions through the 
- * nrf_client_t object.
+ * Alarm callback, called from the alarm interrupt, which ends
+ * a CE pulse started by pulse_ce.
  * 
- * @param client nrf_client_t struct
+ * @param id alarm ID
+ * @param user_data nrf_driver_t instance
  * 
- * @return NRF_MNGR_OK (3), ERROR (0)
+ * @return 0, so the alarm does not repeat
  */
-fn_status_t nrf_driver_create_client(nrf_client_t *client) {
+static int64_t ce_pulse_callback(alarm_id_t id, void *user_data) {
 
-  client->configure = nrf_driver_configure;
-  client->initialise = nrf_driver_initialise;
+  nrf_driver_t *driver = (nrf_driver_t *)user_data;
 
-  client->rx_destination = nrf_driver_rx_destination;
-  client->tx_destination = nrf_driver_tx_destination;
+  ce_put_low(driver->user_pins.ce);
 
-  client->payload_size = nrf_driver_payload_size;
-  client->dyn_payloads_enable = nrf_driver_dyn_payloads_enable;
-  client->dyn_payloads_disable = nrf_driver_dyn_payloads_disable;
+  driver->ce_pulse_alarm = 0;
 
-  client->auto_retransmission = nrf_driver_auto_retransmission;
+  return 0;
+}
 
-  client->rf_channel = nrf_driver_rf_channel;
-  client->rf_data_rate = nrf_driver_rf_data_rate;
-  client->rf_power = nrf_driver_rf_power;
 
-  client->send_packet = nrf_driver_send_packet;
-  client->read_packet = nrf_driver_read_packet;
-  client->is_packet = nrf_driver_is_packet;
+/**
+ * Cancels the alarm of a CE pulse in progress, before CE is 
+ * driven HIGH to be held, so the alarm does not drive it LOW.
+ * CE is left HIGH.
+ * 
+ * @param driver nrf_driver_t instance
+ */
+static void cancel_ce_pulse(nrf_driver_t *driver) {
 
-  client->standby_mode = nrf_driver_standby_mode;
-  client->receiver_mode = nrf_driver_receiver_mode;
+  alarm_id_t alarm = driver->ce_pulse_alarm;
 
-  return NRF_MNGR_OK;
-}
+  if (alarm > 0)
+  {
+    cancel_alarm(alarm);
 
+    driver->ce_pulse_alarm = 0;
+  }
 
-/************************************
- *     Static Utility Functions     *
- ************************************/
+  return;
+}
 
 
 /**
- * Validates user nrf_manager_t configuration.
+ * Alarm callback, called from the alarm interrupt, which advances
+ * the duty cycle started by nrf_driver_duty_cycle_start through 
+ * its phases and returns the delay until the next phase. Phases 
+ * which write CONFIG are retried after DUTY_RETRY_US, if the alarm
+ * preempted an SPI transfer.
  * 
- * @param reg register to write the buffer to
- * @param buffer value to be held in the register
- * @param size size of the buffer
+ * @param id alarm ID
+ * @param user_data nrf_driver_t instance
  * 
- * @return NRF_MNGR_OK (3), ERROR (0)
+ * @return delay until the next phase (us), negative for a retry, 0 once stopped
  */
-static fn_status_t validate_config(nrf_manager_t *user_config) {
+static int64_t duty_cycle_callback(alarm_id_t id, void *user_data) {
 
-  uint8_t valid_members = 0;
+  nrf_driver_t *driver = (nrf_driver_t *)user_data;
 
-  // validate address width
-  if ((user_config->address_width) >= AW_3_BYTES && (user_config->address_width <= AW_5_BYTES))
-  {
-    valid_members++;
-  }
+  // positive delay is from the time this alarm was due, so periods do not drift
+  int64_t delay_us = -DUTY_RETRY_US;
 
-  // validate RF Channel
-  if ((user_config->channel >= 2) && (user_config->channel <= 125))
+  switch (driver->duty_phase)
   {
-    valid_members++;
-  }
+    case DUTY_WAKE:
+      if (!is_spi_held(driver))
+      {
+        // set PWR_UP bit, NRF24L01+ enters Standby-I mode after 1.5ms
+        w_shadow_register(driver, CONFIG, driver->shadow[CONFIG] | (SET_BIT << CONFIG_PWR_UP));
 
-  // validate RF data rate
-  switch (user_config->data_rate)
-  {
-    case RF_DR_1MBPS:
-      valid_members++;
+        driver->mode = STANDBY_I;
+        driver->duty_phase = DUTY_LISTEN;
+
+        delay_us = POWER_UP_US;
+      }
     break;
 
-    case RF_DR_2MBPS:
-      valid_members++;
+    case DUTY_LISTEN:
+      // Drive CE HIGH, NRF24L01+ enters RX Mode after 130μS
+      ce_put_high(driver->user_pins.ce);
+
+      driver->mode = RX_MODE;
+      driver->duty_phase = DUTY_READY;
+
+      delay_us = RX_SETTLE_US;
     break;
 
-    case RF_DR_250KBPS:
-      valid_members++;
+    case DUTY_READY:
+      driver->is_rx_ready = true;
+      driver->duty_phase = DUTY_SLEEP;
+
+      __sev();
+
+      delay_us = driver->duty_listen_us;
     break;
-    
+
+    case DUTY_SLEEP:
+      if (!is_spi_held(driver))
+      {
+        // Drive CE LOW, ending the listen window
+        ce_put_low(driver->user_pins.ce);
+
+        driver->is_rx_ready = false;
+
+        // packets latched, but not drained by irq_handler, are drained before Power Down
+        if ((driver->rx_ring != NULL) && driver->is_irq_pending) { drain_rx_ring(driver); }
+
+        // clear PWR_UP bit, NRF24L01+ enters Power Down mode
+        w_shadow_register(driver, CONFIG, driver->shadow[CONFIG] & ~(SET_BIT << CONFIG_PWR_UP));
+
+        driver->mode = POWER_DOWN;
+        driver->duty_phase = DUTY_WAKE;
+
+        delay_us = driver->duty_period_us - (POWER_UP_US + RX_SETTLE_US + driver->duty_listen_us);
+      }
+    break;
+
+    case DUTY_STOP:
+      // NRF24L01+ has entered Standby-I mode, so the duty cycle has stopped
+      driver->duty_alarm = 0;
+      driver->mode = STANDBY_I;
+      driver->is_duty_cycle = false;
+
+      __sev();
+
+      delay_us = 0;
+    break;
+
     default:
     break;
   }
 
-  // validate dynamic payloads setting
-  if ((user_config->dyn_payloads == DYNPD_ENABLE) || (user_config->dyn_payloads == DYNPD_DISABLE))
-  {
-    valid_members++;
-  }
+  return delay_us;
+}
 
-  // validate RF power setting
-  // validate RF power setting
-  for (size_t rf_pow = RF_PWR_NEG_18DBM; rf_pow <= RF_PWR_0DBM; rf_pow += 2)
-  {
-    if (user_config->power == rf_pow) { valid_members++; }
-  }
 
-  // validate retransmission count
-  if (user_config->retr_count <= ARC_15RT)
+/**
+ * Closes an open SPI session, releasing the SPI interface 
+ * or the PIO state machine.
+ * 
+ * @param driver nrf_driver_t instance
+ */
+static void close_spi_session(nrf_driver_t *driver) {
+
+  if (driver->irq_pin != IRQ_PIN_UNUSED)
   {
-    valid_members++;
+    pin_manager_release_irq(driver->irq_pin, driver->irq_handler);
+
+    driver->irq_pin = IRQ_PIN_UNUSED;
+    driver->is_irq_pending = false;
   }
 
-  // validate retransmission delay
-  for (size_t delay = ARD_250US; delay <= ARD_1000US; delay += 16)
+  if (driver->is_spi_session)
   {
-    if (user_config->retr_delay == delay) { valid_members++; }
-  }
+    if (driver->is_pio_spi)
+    {
+      pio_manager_deinit(&(driver->user_pio));
 
-  fn_status_t status = (valid_members == 7) ? NRF_MNGR_OK : ERROR;
+    } else {
 
-  return status;
-} 
+      spi_manager_close(driver->user_spi.instance);
+    }
+
+    driver->is_spi_session = false;
+    driver->is_pio_spi = false;
+  }
 
+  return;
+}
 
 
 /**
- * Writes the buffer value to the specified register.
- * 
- * @param reg register to write the buffer to
- * @param buffer value to be held in the register
- * @param size size of the buffer
+ * Holds the SPI bus, for a transfer or a sequence of transfers, so
+ * an interrupt handler does not start a transfer which interleaves
+ * with it. The hold is taken on the SPI instance, shared by every 
+ * driver instance on the same bus, or for the PIO state machine,
+ * which is used by this driver instance alone.
  * 
- * @return SPI_MNGR_OK (2), ERROR (0)
+ * @param driver nrf_driver_t instance
  */
-static fn_status_t w_register(register_map_t reg, const void *buffer, size_t size) {
-
-  uint8_t *buffer_ptr = (uint8_t *)buffer;
+static void hold_spi(nrf_driver_t *driver) {
 
-  // buffer_size + 1 (register address)
-  size_t total_size = size + 1;
-
-  uint8_t tx_buffer[total_size]; // SPI Tx buffer
-  uint8_t rx_buffer[total_size]; // SPI Rx buffer
-
-  // ensure 3 MSB are [001] (write to the register)
-  reg = ((REGISTER_MASK & reg) | W_REGISTER);
-
-  tx_buffer[0] = reg; // store register in tx_buffer[0]
+  if (driver->is_pio_spi)
+  {
+    driver->spi_busy++;
 
-  // store byte(s) in buffer (buffer_ptr) into tx_buffer[total_size]
-  for (size_t i = 0; i < size; i++) { tx_buffer[i + 1] = *(buffer_ptr + i); }
+  } else {
 
-  spi_manager_t *spi = &(nrf_driver.user_spi);
-  
-  csn_put_low(nrf_driver.user_pins.csn); // drive CSN pin LOW
-  fn_status_t status = spi_manager_transfer(spi->instance, tx_buffer, rx_buffer, total_size);
-  csn_put_high(nrf_driver.user_pins.csn); // drive CSN pin HIGH
+    spi_manager_hold(driver->user_spi.instance);
+  }
 
-  return status; // return error flag value
+  return;
 }
 
 
 /**
- * Reads one byte from the specified register.
- *  
- * @param reg register address
+ * Releases the hold on the SPI bus, taken by hold_spi.
  * 
- * @return register value 
+ * @param driver nrf_driver_t instance
  */
-static uint8_t r_register_byte(register_map_t reg) {
+static void release_spi(nrf_driver_t *driver) {
 
-  /**
-   * NRF24L01 returns the STATUS register value,
-   * hence why tx_buffer and rx_buffer are two
-   * bytes. The first index of rx_buffer will
-   * hold the STATUS register value. The second
-   * index will hold the value of the specified
-   * register.
-   */
-  uint8_t tx_buffer[TWO_BYTES] = { reg, NOP };
-  uint8_t rx_buffer[TWO_BYTES] = { 0, 0 };
+  if (driver->is_pio_spi)
+  {
+    driver->spi_busy--;
 
-  spi_manager_t *spi = &(nrf_driver.user_spi);
+  } else {
 
-  csn_put_low(nrf_driver.user_pins.csn); // drive CSN pin LOW
-  spi_manager_transfer(spi->instance, tx_buffer, rx_buffer, TWO_BYTES);
-  csn_put_high(nrf_driver.user_pins.csn); // drive CSN pin HIGH
+    spi_manager_release(driver->user_spi.instance);
+  }
 
-  // *(rx_buffer + 0) holds STATUS register value
-  return *(rx_buffer + 1);
+  return;
 }
 
 
 /**
- * Reads a number of bytes from the specified register.
+ * Indicates if the SPI bus of the driver instance is held, by 
+ * this or another driver instance on the same bus, so a transfer
+ * must not be started from an interrupt handler.
  * 
- * NOTE: Works the same as r_register_byte function. 
- * Some registers hold more than one byte, such as
- * RX_ADDR_P0 - RX_ADDR_P5 registers (5 bytes). An
- * array buffer is used to store the register value.
+ * @param driver nrf_driver_t instance
  * 
- * @param reg register address
- * @param buffer buffer for register value
- * @param buffer_size size of buffer
+ * @return true if the SPI bus is held
+ */
+static bool is_spi_held(nrf_driver_t *driver) {
+
+  return (driver->is_pio_spi) ? (driver->spi_busy != 0) : spi_manager_is_held(driver->user_spi.instance);
+}
+
+
+/**
+ * Performs a CSN framed transfer to the NRF24L01, through
+ * the SPI interface or the PIO state machine.
+ * 
+ * @param driver nrf_driver_t instance
+ * @param tx_buffer write buffer
+ * @param rx_buffer read buffer
+ * @param len bytes in buffers
  * 
  * @return SPI_MNGR_OK (2), ERROR (0)
  */
-static fn_status_t r_register_bytes(register_map_t reg, uint8_t *buffer, size_t buffer_size) {
+static fn_status_t spi_transfer(nrf_driver_t *driver, const uint8_t *tx_buffer, uint8_t *rx_buffer, size_t len) {
 
-  /**
-   * NRF24L01 returns the STATUS register value, hence why tx_buffer 
-   * and rx_buffer are the size of buffer_size + 1. The first index 
-   * of rx_buffer will hold the STATUS register  value. The remainder 
-   * will hold the value of the specified register.
-   */
-  size_t total_size = buffer_size + 1;
+  fn_status_t status = ERROR;
 
-  uint8_t tx_buffer[total_size];
-  uint8_t rx_buffer[total_size];
+  hold_spi(driver);
 
-  // store register address in tx_buffer[0]
-  *(tx_buffer + 0) = reg;
+  if (driver->is_pio_spi)
+  {
+    // CSN is driven by the PIO state machine
+    status = pio_manager_transfer(&(driver->user_pio), tx_buffer, rx_buffer, len);
 
-  // fill rest of tx_buffer with NOP
-  for (size_t i = 1; i < total_size; i++) { *(tx_buffer + i) = NOP; }
+  } else {
 
-  spi_manager_t *spi = &(nrf_driver.user_spi);
+    csn_put_low(driver->user_pins.csn); // drive CSN pin LOW
+    status = spi_manager_transfer(driver->user_spi.instance, tx_buffer, rx_buffer, len);
+    csn_put_high(driver->user_pins.csn); // drive CSN pin HIGH
+  }
 
-  csn_put_low(nrf_driver.user_pins.csn); // drive CSN pin LOW
-  fn_status_t status = spi_manager_transfer(spi->instance, tx_buffer, rx_buffer, total_size);
-  csn_put_high(nrf_driver.user_pins.csn); // drive CSN pin HIGH
-  
-  // skip rx_buffer[0] (STATUS value) and transfer remaining values to buffer
-  for (size_t i = 1; i < total_size; i++) { *(buffer++) = *(rx_buffer + i); }
+  release_spi(driver);
+
+  if ((status == SPI_MNGR_OK) && (tx_buffer != NULL))
+  {
+    track_status(driver, tx_buffer[0], (len > ONE_BYTE) ? tx_buffer[1] : NOP, rx_buffer);
+  }
 
   return status;
 }
 
 
-
-
-
 /**
- * Set the specified address width in the SETUP_AW register. By default,
- * the driver uses an address width of 5 bytes.
+ * Writes a command byte, followed by the bytes in buffer, to the 
+ * NRF24L01 in one CSN frame, through the SPI interface or the PIO
+ * state machine. The buffer is streamed directly, without a copy,
+ * using DMA through the SPI interface if the buffer is a payload.
  * 
- * @param address_width AW_3_BYTES, AW_4_BYTES, AW_5_BYTES
+ * @param driver nrf_driver_t instance
+ * @param command command byte (W_REGISTER, W_TX_PAYLOAD etc.)
+ * @param buffer write buffer
+ * @param len bytes in buffer
+ * @param status_reg STATUS register value, clocked in with the command, or NULL
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
  */
-/*
-static fn_status_t set_address_width(address_width_t address_width) {
+static fn_status_t spi_write_command(nrf_driver_t *driver, uint8_t command, const void *buffer, size_t len, uint8_t *status_reg) {
 
-  spi_manager_t *spi = &(nrf_driver.user_spi);
-
-  // initialise SPI for function duration
-  spi_manager_init_spi(spi->instance, spi->baudrate); 
+  fn_status_t status = ERROR;
 
-  // holds OK (0) or REGISTER_W_FAIL (3)
-  fn_status_t status = w_register(SETUP_AW, &address_width, ONE_BYTE);
+  // STATUS register value, always clocked in, for track_status
+  uint8_t command_status = 0;
 
-  nrf_manager_t *config = &(nrf_driver.user_config);
+  hold_spi(driver);
 
-  if (status == NRF_MNGR_OK)
+  if (driver->is_pio_spi)
   {
-    config->address_width = address_width;
+    status = pio_manager_write_command(&(driver->user_pio), command, (const uint8_t *)buffer, len, &command_status);
+
+  } else {
+
+    // CSN is driven LOW and HIGH by spi_manager
+    status = spi_manager_write_command(driver->user_spi.instance, driver->user_pins.csn, command, (const uint8_t *)buffer, len, &command_status);
   }
 
-  // deinitialise SPI at function end
-  spi_manager_deinit_spi(spi->instance); 
+  release_spi(driver);
+
+  if (status == SPI_MNGR_OK)
+  {
+    track_status(driver, command, (len > ZERO_BYTES) ? ((const uint8_t *)buffer)[0] : NOP, &command_status);
+
+    if (status_reg != NULL) { *status_reg = command_status; }
+  }
 
   return status;
 }
-*/
+
 
 /**
- * Enables Enhanced ShockBurst™ auto acknowledgment (AA) 
- * function on the specified data pipe(s).
+ * Performs a batch of CSN framed transfers to the NRF24L01,
+ * back to back, through the SPI interface or the PIO state 
+ * machine.
  * 
- * @param setting ENAA_NONE, ENAA_P0, ENAA_P1, ENAA_P2, ENAA_P3, ENAA_P4, ENAA_P5, ENAA_ALL
+ * @param driver nrf_driver_t instance
+ * @param frames array of frames
+ * @param count number of frames
  * 
  * @return SPI_MNGR_OK (2), ERROR (0)
  */
-/*
-static fn_status_t enable_auto_acknowledge(en_auto_ack_t setting) {
+static fn_status_t spi_transfer_batch(nrf_driver_t *driver, const spi_manager_frame_t *frames, size_t count) {
 
-  spi_manager_t *spi = &(nrf_driver.user_spi);
-
-  // initialise SPI for function duration
-  spi_manager_init_spi(spi->instance, spi->baudrate); 
+  fn_status_t status = ERROR;
 
-  fn_status_t status = w_register(EN_AA, &setting, ONE_BYTE);
+  hold_spi(driver);
 
-  // deinitialise SPI at function end
-  spi_manager_deinit_spi(spi->instance); 
+  if (driver->is_pio_spi)
+  {
+    status = pio_manager_transfer_batch(&(driver->user_pio), frames, count);
 
-  return status;
-}
-*/
+  } else {
 
+    status = spi_manager_transfer_batch(driver->user_spi.instance, driver->user_pins.csn, frames, count);
+  }
 
-/**
- * Writes FLUSH_TX instruction over SPI to NRF24L01,
- * which will flush the TX FIFO.
- */
-static void flush_tx_fifo(void) {
-  
-  csn_put_low(nrf_driver.user_pins.csn);
-  sleep_us(2);
-  spi_write_blocking(nrf_driver.user_spi.instance, (uint8_t[]){FLUSH_TX}, ONE_BYTE);
-  sleep_us(2);
-  csn_put_high(nrf_driver.user_pins.csn);
+  release_spi(driver);
 
-  return;
-}
+  // frames are tracked in the order they were clocked
+  for (size_t i = 0; (status == SPI_MNGR_OK) && (i < count); i++)
+  {
+    const uint8_t *tx_buffer = frames[i].tx_buffer;
 
+    uint8_t command = (tx_buffer != NULL) ? tx_buffer[0] : NOP;
+    uint8_t value = ((tx_buffer != NULL) && (frames[i].len > ONE_BYTE)) ? tx_buffer[1] : NOP;
 
-/**
- * Writes FLUSH_RX instruction over SPI to NRF24L01,
- * which will flush the RX FIFO.
- */
-static void flush_rx_fifo(void) {
-  
-  csn_put_low(nrf_driver.user_pins.csn);
-  sleep_us(2);
-  spi_write_blocking(nrf_driver.user_spi.instance, (uint8_t[]){FLUSH_RX}, ONE_BYTE);
-  sleep_us(2);
-  csn_put_high(nrf_driver.user_pins.csn);
+    track_status(driver, command, value, frames[i].rx_buffer);
+  }
 
-  return;
+  return status;
 }
 
 
 /**
- * Check STATUS register RX_DR, TX_DS and MAX_RT bits and 
- * return a internal_status_irq_t value, indicating which 
- * bit is asserted.
+ * Tracks the STATUS register value clocked in by a command, 
+ * which the NRF24L01 returns as the first byte of every SPI
+ * transfer. The STATUS value is clocked in before the command 
+ * takes effect, so bits changed by the command itself are 
+ * applied to the tracked value afterwards. IRQ bits are sticky 
+ * until reset by writing 1, so a tracked IRQ bit is still set
+ * on the NRF24L01, though a bit asserted since may be missing.
  * 
- * @return NONE_ASSERTED (0), RX_DR_ASSERTED (1), 
- * TX_DS_ASSERTED (2), MAX_RT_ASSERTED (3)
+ * @param driver nrf_driver_t instance
+ * @param command command byte of the transfer
+ * @param value first byte written after the command (NOP if none)
+ * @param status_reg STATUS register value clocked in or NULL (discarded)
  */
-static fn_status_irq_t check_status_irq(uint8_t *rx_p_no) {
-
-  // value of STATUS register
-  uint8_t status = r_register_byte(STATUS);
+static void track_status(nrf_driver_t *driver, uint8_t command, uint8_t value, const uint8_t *status_reg) {
 
-  // test which interrupt was asserted
-  uint8_t rx_dr = (status >> STATUS_RX_DR) & SET_BIT; // Asserted when packet received
-  uint8_t tx_ds = (status >> STATUS_TX_DS) & SET_BIT; // Asserted when auto-acknowledge received
-  uint8_t max_rt = (status >> STATUS_MAX_RT) & SET_BIT; // Asserted when max retries reached
+  if (status_reg != NULL) { driver->status_reg = status_reg[0]; }
 
-  // NONE_ASSERTED (0), RX_DR_ASSERTED (1), TX_DS_ASSERTED (2), MAX_RT_ASSERTED (3)
-  fn_status_irq_t asserted_bit = NONE_ASSERTED;
-
-  // used to write 1 to asserted bit to reset
-  uint8_t reset_bit = 0; 
-
-  if (rx_dr)
-  { 
-    if (rx_p_no != NULL) { *rx_p_no = (status >> STATUS_RX_P_NO) & STATUS_RX_P_NO_MASK; }
-
-    reset_bit = (SET_BIT << STATUS_RX_DR);
-    // reset RX_DR (bit 6) in STATUS register by writing 1
-    w_register(STATUS, &reset_bit, ONE_BYTE);
-    // indicate RX_DR bit asserted in STATUS register
-    asserted_bit = RX_DR_ASSERTED;
-  }
-
-  if (tx_ds)
+  // W_REGISTER STATUS resets each IRQ bit written as 1
+  if (command == ((REGISTER_MASK & STATUS) | W_REGISTER))
   {
-    reset_bit = (SET_BIT << STATUS_TX_DS);
-    // reset TX_DS (bit 5) in STATUS register by writing 1
-    w_register(STATUS, &reset_bit, ONE_BYTE);
-    // indicate TX_DS bit asserted in STATUS register
-    asserted_bit = TX_DS_ASSERTED; 
+    driver->status_reg &= ~(value & STATUS_INTERRUPT_MASK);
   }
 
-  if (max_rt)
+  // RX_P_NO no longer describes the top of the RX FIFO (7 is unknown or empty)
+  if ((command == R_RX_PAYLOAD) || (command == FLUSH_RX))
   {
-    reset_bit = (SET_BIT << STATUS_MAX_RT);
-    // reset MAX_RT (bit 4) in STATUS register by writing 1
-    w_register(STATUS, &reset_bit, ONE_BYTE);
-    // indicate MAX_RT bit asserted in STATUS register
-    asserted_bit = MAX_RT_ASSERTED;
-
-    flush_tx_fifo();
+    driver->status_reg |= (STATUS_RX_P_NO_MASK << STATUS_RX_P_NO);
   }
 
-  return asserted_bit;
+  // an empty TX FIFO is not full
+  if (command == FLUSH_TX) { driver->status_reg &= ~(SET_BIT << STATUS_TX_FULL); }
+
+  return;
 }
@@ -134,6 +134,10 @@ typedef struct pin_manager_s
   uint8_t sck;
   uint8_t csn;
   uint8_t ce;
+
+  // optional IRQ pin, used if is_irq is set, so GPIO 0 may be the IRQ pin
+  uint8_t irq;
+  bool is_irq;
 } pin_manager_t;
 
 
@@ -158,12 +162,86 @@ typedef struct nrf_manager_s
 } nrf_manager_t;
 
 
+// outcome of a packet transmission, with OBSERVE_TX register counts
+typedef struct tx_status_s
+{
+  // TX_DS_ASSERTED (acknowledged), MAX_RT_ASSERTED (max retransmissions reached)
+  fn_status_irq_t irq;
+
+  // retransmissions of the packet (OBSERVE_TX ARC_CNT)
+  uint8_t retransmits;
+
+  // packets lost, since RF channel was last set (OBSERVE_TX PLOS_CNT)
+  uint8_t lost;
+
+  // an ACK payload was received with the acknowledgement (read as a packet)
+  bool is_ack_payload;
+} tx_status_t;
+
+
+// a packet read from the RX FIFO by receive_batch
+typedef struct rx_packet_s
+{
+  // payload bytes
+  uint8_t payload[MAX_BYTES];
+
+  // payload width in bytes
+  uint8_t width;
+
+  // data pipe the packet was received on
+  data_pipe_t data_pipe;
+
+  // time the packet was read from the RX FIFO (us since boot)
+  uint32_t timestamp_us;
+} rx_packet_t;
+
+
+// a packet queued by tx_enqueue
+typedef struct tx_entry_s
+{
+  // payload bytes
+  uint8_t payload[MAX_BYTES];
+
+  // payload width in bytes
+  uint8_t width;
+} tx_entry_t;
+
+
+// outcome of a packet queued by tx_enqueue
+typedef struct tx_result_s
+{
+  // sequence number passed by tx_enqueue
+  uint32_t sequence;
+
+  // TX_DS_ASSERTED (acknowledged) or MAX_RT_ASSERTED (not acknowledged)
+  fn_status_irq_t irq;
+} tx_result_t;
+
+
+// completion callback for a packet sent by send_packet_async
+typedef void (*tx_callback_t)(const tx_status_t *tx_status, void *user_data);
+
+
+// number of NRF24L01 driver instances (nrf_client_t objects bound at once)
+#define NRF_DRIVER_MAX_INSTANCES 2
+
+
+// driver instance state for one NRF24L01, defined in nrf24_driver.c
+typedef struct nrf_driver_s nrf_driver_t;
+
+
 // provides access to nrf_driver public functions
 typedef struct nrf_client_s
 {
+  // driver instance bound by nrf_driver_create_client
+  nrf_driver_t *driver;
+
   // configure user pins and the SPI interface
   fn_status_t (*configure)(pin_manager_t* user_pins, uint32_t baudrate_hz);
 
+  // configure user pins and a PIO state machine, in place of the SPI interface
+  fn_status_t (*configure_pio)(pin_manager_t* user_pins, uint32_t baudrate_hz);
+
   // initialise the NRF24L01. A NULL argument will use default configuration.
   fn_status_t (*initialise)(nrf_manager_t* user_config);
 
@@ -182,6 +260,15 @@ typedef struct nrf_client_s
   // disables dynamic payloads
   fn_status_t (*dyn_payloads_disable)(void);
 
+  // enables ACK payloads (and dynamic payloads)
+  fn_status_t (*ack_payloads_enable)(void);
+
+  // disables ACK payloads
+  fn_status_t (*ack_payloads_disable)(void);
+
+  // queue a payload, returned with the next auto-acknowledgement on the data pipe
+  fn_status_t (*ack_payload)(data_pipe_t data_pipe, const void *payload, size_t size);
+
   // set packet auto-retransmission delay and count configurations
   fn_status_t (*auto_retransmission)(retr_delay_t delay, retr_count_t count);
 
@@ -197,23 +284,108 @@ typedef struct nrf_client_s
   // send a packet
   fn_status_t (*send_packet)(const void *tx_packet, size_t size);
 
+  // send a packet, returning without waiting for the outcome
+  fn_status_t (*send_packet_async)(const void *tx_packet, size_t size);
+
+  // indicates if a packet sent by send_packet_async has completed and its outcome
+  fn_status_t (*poll_tx)(tx_status_t *tx_status);
+
+  // set a callback, called by poll_tx when a packet sent by send_packet_async completes
+  fn_status_t (*tx_callback)(tx_callback_t callback, void *user_data);
+
+  // send count packets back to back, keeping the TX FIFO topped up with CE held HIGH
+  fn_status_t (*send_stream)(const void *tx_packets, size_t size, size_t count, fn_status_irq_t *outcomes);
+
+  // send a packet without auto-acknowledgement, without waiting
+  fn_status_t (*send_packet_noack)(const void *tx_packet, size_t size);
+
+  // send an array of packets without auto-acknowledgement, keeping the TX FIFO full
+  fn_status_t (*send_stream_noack)(const void *tx_packets, size_t size, size_t count);
+
+  // retransmit a payload every interval_us, uploaded once, with CE pulses
+  fn_status_t (*beacon_start)(const void *payload, size_t size, uint32_t interval_us);
+
+  // replace the beacon payload, between transmissions
+  fn_status_t (*beacon_update)(const void *payload, size_t size);
+
+  // stop the beacon
+  fn_status_t (*beacon_stop)(void);
+
+  // start a duty-cycled receiver, listening for listen_us each period_us
+  fn_status_t (*duty_cycle_start)(uint32_t period_us, uint32_t listen_us);
+
+  // stop the duty-cycled receiver
+  fn_status_t (*duty_cycle_stop)(void);
+
   // read a received packet
   fn_status_t (*read_packet)(void *rx_packet, size_t size);
 
   // indicates if a packet has been received and is ready to read
   fn_status_t (*is_packet)(uint8_t *rx_p_no);
 
+  // poll and consume every STATUS register event, as a bitmask
+  fn_status_t (*poll_events)(uint8_t *events, uint8_t *rx_p_no);
+
+  // read every packet in the RX FIFO, with its data pipe and width
+  fn_status_t (*receive_batch)(rx_packet_t *rx_packets, size_t max_packets, size_t *count);
+
+  // enable a software RX ring, filled from the IRQ pin interrupt
+  fn_status_t (*rx_ring)(rx_packet_t *slots, size_t depth);
+
+  // take the oldest packet from the RX ring, without waiting
+  fn_status_t (*rx_ring_pop)(rx_packet_t *rx_packet);
+
+  // packets held in the RX ring and packets discarded as it was full
+  fn_status_t (*rx_ring_stats)(size_t *count, uint32_t *overflows);
+
+  // enable a software TX queue, pumped into the TX FIFO from the IRQ pin interrupt
+  fn_status_t (*tx_queue)(tx_entry_t *entries, tx_result_t *results, size_t depth);
+
+  // queue a packet for transmission, without waiting
+  fn_status_queue_t (*tx_enqueue)(const void *tx_packet, size_t size, uint32_t *sequence);
+
+  // take the oldest outcome of a queued packet
+  fn_status_t (*tx_result)(tx_result_t *result);
+
+  // run the radio engine on core 1, owning SPI, IRQ pin and mode
+  fn_status_t (*engine_start)(void);
+
+  // stop the radio engine on core 1
+  fn_status_t (*engine_stop)(void);
+
   // switch NRF24L01 to TX Mode
   fn_status_t (*standby_mode)(void);
 
   // switch NRF24L01 to RX Mode
   fn_status_t (*receiver_mode)(void);
+
+  // set CSN setup and hold times (nS) around SPI transfers
+  fn_status_t (*csn_timing)(uint32_t setup_ns, uint32_t hold_ns);
+
+  // set CE pulse width (uS), which starts a transmission
+  fn_status_t (*ce_pulse)(uint32_t width_us);
+
+  // close the SPI session opened by configure
+  fn_status_t (*close)(void);
+
+  // verify registers against the register shadow, rewriting any which differ
+  fn_status_t (*sync_registers)(void);
+
+  // copy the current configuration, held in the register shadow
+  fn_status_t (*get_config)(nrf_manager_t *user_config);
+
+  // copy the STATUS register value, clocked in by the last command
+  fn_status_t (*last_status)(uint8_t *status_reg);
 } nrf_client_t;
 
 
 /**
- * Takes the nrf_client_t argument and sets the function pointers
- * to the appropriate nrf_driver_[function_pointer_name] function.
+ * Binds the nrf_client_t argument to a free driver instance and 
+ * sets the function pointers to call the appropriate 
+ * nrf_driver_[function_pointer_name] function with that instance.
+ * Up to NRF_DRIVER_MAX_INSTANCES clients may be bound at once, one
+ * for each NRF24L01, on separate SPI interfaces or on one SPI 
+ * interface with separate CSN pins.
  * 
  * @param client nrf_client_t struct
  * 
@@ -222,4 +394,115 @@ typedef struct nrf_client_s
 fn_status_t nrf_driver_create_client(nrf_client_t *client);
 
 
+/**
+ * Closes the SPI session of the driver instance bound to the 
+ * nrf_client_t and frees the instance for another client.
+ * 
+ * @param client nrf_client_t struct
+ * 
+ * @return NRF_MNGR_OK (3), ERROR (0)
+ */
+fn_status_t nrf_driver_destroy_client(nrf_client_t *client);
+
+
+/**
+ * Driver functions taking a driver instance (client.driver), which
+ * the nrf_client_t function pointers of the same name call. See
+ * the nrf_client_t members for a description of each function.
+ */
+fn_status_t nrf_driver_configure(nrf_driver_t *driver, pin_manager_t *user_pins, uint32_t baudrate_hz);
+
+fn_status_t nrf_driver_configure_pio(nrf_driver_t *driver, pin_manager_t *user_pins, uint32_t baudrate_hz);
+
+fn_status_t nrf_driver_initialise(nrf_driver_t *driver, nrf_manager_t *user_config);
+
+fn_status_t nrf_driver_rx_destination(nrf_driver_t *driver, data_pipe_t data_pipe, const uint8_t *buffer);
+
+fn_status_t nrf_driver_tx_destination(nrf_driver_t *driver, const uint8_t *buffer);
+
+fn_status_t nrf_driver_payload_size(nrf_driver_t *driver, data_pipe_t data_pipe, size_t size);
+
+fn_status_t nrf_driver_dyn_payloads_enable(nrf_driver_t *driver);
+
+fn_status_t nrf_driver_dyn_payloads_disable(nrf_driver_t *driver);
+
+fn_status_t nrf_driver_ack_payloads_enable(nrf_driver_t *driver);
+
+fn_status_t nrf_driver_ack_payloads_disable(nrf_driver_t *driver);
+
+fn_status_t nrf_driver_ack_payload(nrf_driver_t *driver, data_pipe_t data_pipe, const void *payload, size_t size);
+
+fn_status_t nrf_driver_auto_retransmission(nrf_driver_t *driver, retr_delay_t delay, retr_count_t count);
+
+fn_status_t nrf_driver_rf_channel(nrf_driver_t *driver, uint8_t channel);
+
+fn_status_t nrf_driver_rf_data_rate(nrf_driver_t *driver, rf_data_rate_t data_rate);
+
+fn_status_t nrf_driver_rf_power(nrf_driver_t *driver, rf_power_t rf_pwr);
+
+fn_status_t nrf_driver_send_packet(nrf_driver_t *driver, const void *tx_packet, size_t size);
+
+fn_status_t nrf_driver_send_packet_async(nrf_driver_t *driver, const void *tx_packet, size_t size);
+
+fn_status_t nrf_driver_poll_tx(nrf_driver_t *driver, tx_status_t *tx_status);
+
+fn_status_t nrf_driver_tx_callback(nrf_driver_t *driver, tx_callback_t callback, void *user_data);
+
+fn_status_t nrf_driver_send_stream(nrf_driver_t *driver, const void *tx_packets, size_t size, size_t count, fn_status_irq_t *outcomes);
+
+fn_status_t nrf_driver_send_packet_noack(nrf_driver_t *driver, const void *tx_packet, size_t size);
+
+fn_status_t nrf_driver_send_stream_noack(nrf_driver_t *driver, const void *tx_packets, size_t size, size_t count);
+
+fn_status_t nrf_driver_beacon_start(nrf_driver_t *driver, const void *payload, size_t size, uint32_t interval_us);
+
+fn_status_t nrf_driver_beacon_update(nrf_driver_t *driver, const void *payload, size_t size);
+
+fn_status_t nrf_driver_beacon_stop(nrf_driver_t *driver);
+
+fn_status_t nrf_driver_duty_cycle_start(nrf_driver_t *driver, uint32_t period_us, uint32_t listen_us);
+
+fn_status_t nrf_driver_duty_cycle_stop(nrf_driver_t *driver);
+
+fn_status_t nrf_driver_read_packet(nrf_driver_t *driver, void *rx_packet, size_t size);
+
+fn_status_t nrf_driver_is_packet(nrf_driver_t *driver, uint8_t *rx_p_no);
+
+fn_status_t nrf_driver_poll_events(nrf_driver_t *driver, uint8_t *events, uint8_t *rx_p_no);
+
+fn_status_t nrf_driver_receive_batch(nrf_driver_t *driver, rx_packet_t *rx_packets, size_t max_packets, size_t *count);
+
+fn_status_t nrf_driver_rx_ring(nrf_driver_t *driver, rx_packet_t *slots, size_t depth);
+
+fn_status_t nrf_driver_rx_ring_pop(nrf_driver_t *driver, rx_packet_t *rx_packet);
+
+fn_status_t nrf_driver_rx_ring_stats(nrf_driver_t *driver, size_t *count, uint32_t *overflows);
+
+fn_status_t nrf_driver_tx_queue(nrf_driver_t *driver, tx_entry_t *entries, tx_result_t *results, size_t depth);
+
+fn_status_queue_t nrf_driver_tx_enqueue(nrf_driver_t *driver, const void *tx_packet, size_t size, uint32_t *sequence);
+
+fn_status_t nrf_driver_tx_result(nrf_driver_t *driver, tx_result_t *result);
+
+fn_status_t nrf_driver_engine_start(nrf_driver_t *driver);
+
+fn_status_t nrf_driver_engine_stop(nrf_driver_t *driver);
+
+fn_status_t nrf_driver_standby_mode(nrf_driver_t *driver);
+
+fn_status_t nrf_driver_receiver_mode(nrf_driver_t *driver);
+
+fn_status_t nrf_driver_csn_timing(nrf_driver_t *driver, uint32_t setup_ns, uint32_t hold_ns);
+
+fn_status_t nrf_driver_ce_pulse(nrf_driver_t *driver, uint32_t width_us);
+
+fn_status_t nrf_driver_close(nrf_driver_t *driver);
+
+fn_status_t nrf_driver_sync_registers(nrf_driver_t *driver);
+
+fn_status_t nrf_driver_get_config(nrf_driver_t *driver, nrf_manager_t *user_config);
+
+fn_status_t nrf_driver_last_status(nrf_driver_t *driver, uint8_t *status_reg);
+
+
 #endif // NRF24L01_H
@@ -18,6 +18,7 @@
 
 #include "pin_manager.h"
 #include "hardware/gpio.h"
+#include "hardware/irq.h"
 
 
 void csn_put_high(uint8_t csn) {
@@ -48,6 +49,11 @@ void ce_put_low(uint8_t ce) {
   return;
 }
 
+bool irq_is_low(uint8_t irq) {
+
+  return gpio_get(irq) == LOW;
+}
+
 
 /**
  * Validates the SPI GPIO pin numbers provided.
@@ -93,7 +99,92 @@ fn_status_t pin_manager_configure(uint8_t copi, uint8_t cipo, uint8_t sck, uint8
     // set direction for CE & CSN
     gpio_set_dir(ce, GPIO_OUT);
     gpio_set_dir(csn, GPIO_OUT);
+
+    // CSN idles HIGH, deselecting an NRF24L01 sharing the SPI bus
+    csn_put_high(csn);
   }
   
   return status;
-};
\ No newline at end of file
+};
+
+
+/**
+ * Validates the GPIO pin numbers provided for the PIO SPI 
+ * transport. Each pin must be a GPIO pin and not be used 
+ * more than once.
+ * 
+ * @param pins COPI, CIPO, SCK, CSN & CE pin numbers
+ * 
+ * @return PIN_MNGR_OK (1), ERROR (0)
+ */
+static fn_status_t pin_manager_validate_pio(const uint8_t pins[5]) {
+
+  fn_status_t status = PIN_MNGR_OK;
+
+  for (size_t i = 0; i < 5; i++)
+  {
+    if (pins[i] > GPIO_MAX) { status = ERROR; }
+
+    for (size_t j = i + 1; j < 5; j++)
+    {
+      if (pins[i] == pins[j]) { status = ERROR; }
+    }
+  }
+
+  return status;
+}
+
+
+fn_status_t pin_manager_configure_pio(uint8_t copi, uint8_t cipo, uint8_t sck, uint8_t csn, uint8_t ce) {
+
+  fn_status_t status = pin_manager_validate_pio((uint8_t[]){ copi, cipo, sck, csn, ce });
+
+  if (status)
+  {
+    // initialise CE & set direction, CSN is driven by the PIO state machine
+    gpio_init(ce);
+    gpio_set_dir(ce, GPIO_OUT);
+  }
+
+  return status;
+}
+
+
+// see pin_manager.h
+fn_status_t pin_manager_configure_irq(uint8_t irq, void (*handler)(void)) {
+
+  fn_status_t status = (irq <= GPIO_MAX) ? PIN_MNGR_OK : ERROR;
+
+  if (status)
+  {
+    // IRQ is an active LOW output of the NRF24L01
+    gpio_init(irq);
+    gpio_set_dir(irq, GPIO_IN);
+    gpio_pull_up(irq);
+
+    gpio_add_raw_irq_handler(irq, handler);
+    gpio_set_irq_enabled(irq, GPIO_IRQ_EDGE_FALL, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+  }
+
+  return status;
+}
+
+
+// see pin_manager.h
+void pin_manager_release_irq(uint8_t irq, void (*handler)(void)) {
+
+  gpio_set_irq_enabled(irq, GPIO_IRQ_EDGE_FALL, false);
+  gpio_remove_raw_irq_handler(irq, handler);
+
+  return;
+}
+
+
+// see pin_manager.h
+void pin_manager_irq_acknowledge(uint8_t irq) {
+
+  gpio_acknowledge_irq(irq, GPIO_IRQ_EDGE_FALL);
+
+  return;
+}
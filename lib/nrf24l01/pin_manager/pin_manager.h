@@ -27,7 +27,7 @@ typedef enum spi_pins_e { CIPO, COPI, SCK, ALL_PINS } spi_pins_t;
 
 typedef enum pin_min_e { CIPO_MIN, SCK_MIN = 2, COPI_MIN } pin_min_t;
 
-typedef enum pin_max_e { SCK_MAX = 26, COPI_MAX, CIPO_MAX } pin_max_t;
+typedef enum pin_max_e { SCK_MAX = 26, COPI_MAX, CIPO_MAX, GPIO_MAX } pin_max_t;
 
 // Represents GPIO LOW or HIGH (0 or 1)
 typedef enum pin_direction_e { LOW, HIGH } pin_direction_t;
@@ -47,6 +47,56 @@ typedef enum pin_direction_e { LOW, HIGH } pin_direction_t;
 fn_status_t pin_manager_configure(uint8_t copi, uint8_t cipo, uint8_t sck, uint8_t csn, uint8_t ce);
 
 
+/**
+ * Initializes the CE pin, if the pins validate, for use with the PIO 
+ * SPI transport. Any GPIO pins can be used, as long as they are all 
+ * different. COPI, CIPO, SCK and CSN are initialised by pio_manager.
+ * 
+ * @param copi COPI pin number
+ * @param cipo CIPO pin number
+ * @param sck SCK pin number
+ * @param csn CSN pin number
+ * @param ce CE pin number
+ * 
+ * @return PIN_MNGR_OK (1), ERROR (0)
+ */
+fn_status_t pin_manager_configure_pio(uint8_t copi, uint8_t cipo, uint8_t sck, uint8_t csn, uint8_t ce);
+
+
+/**
+ * Initializes the IRQ pin as an input and adds handler as a raw 
+ * GPIO IRQ handler for the pin, called on its falling edge. The 
+ * NRF24L01 drives IRQ LOW when RX_DR, TX_DS or MAX_RT is asserted.
+ * 
+ * @note handler must call pin_manager_irq_acknowledge.
+ * 
+ * @param irq IRQ pin number
+ * @param handler raw GPIO IRQ handler
+ * 
+ * @return PIN_MNGR_OK (1), ERROR (0)
+ */
+fn_status_t pin_manager_configure_irq(uint8_t irq, void (*handler)(void));
+
+
+/**
+ * Disables the falling edge interrupt on the IRQ pin and 
+ * removes the raw GPIO IRQ handler added for it.
+ * 
+ * @param irq IRQ pin number
+ * @param handler raw GPIO IRQ handler
+ */
+void pin_manager_release_irq(uint8_t irq, void (*handler)(void));
+
+
+/**
+ * Acknowledges the falling edge interrupt on the IRQ pin, 
+ * from its raw GPIO IRQ handler.
+ * 
+ * @param irq IRQ pin number
+ */
+void pin_manager_irq_acknowledge(uint8_t irq);
+
+
 /**
  * Drive CSN pin HIGH.
  * 
@@ -75,4 +125,13 @@ void ce_put_low(uint8_t ce);
  */
 void ce_put_high(uint8_t ce);
 
+/**
+ * Indicates if the IRQ pin is LOW (an interrupt is asserted).
+ * 
+ * @param irq IRQ pin number
+ * 
+ * @return true if the IRQ pin is LOW
+ */
+bool irq_is_low(uint8_t irq);
+
 #endif // PIN_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,271 @@
+/**
+ * Copyright (C) 2021, A. Ridyard.
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License v2.0 as
+ * published by the Free Software Foundation.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * @file pio_manager.c
+ * 
+ * @brief function definitions for communicating with the NRF24L01 
+ * over SPI, through a PIO state machine.
+ */
+
+#include "pio_manager.h"
+#include "hardware/clocks.h"
+#include "nrf24_spi.pio.h"
+
+// PIO state machine cycles per SCK period (see nrf24_spi.pio)
+#define PIO_CYCLES_PER_BIT 4
+
+// NRF24L01 NOP command, clocked out when there is no tx_buffer
+#define PIO_NOP_BYTE 0xFF
+
+// nrf24_spi program state for a PIO block
+typedef struct program_state_s
+{
+  // state machines running the program
+  uint8_t users;
+
+  // program offset in PIO instruction memory
+  uint offset;
+} program_state_t;
+
+// nrf24_spi program state, indexed by PIO block (pio0, pio1)
+static program_state_t program_state[2] = { 
+  { .users = 0, .offset = 0 }, 
+  { .users = 0, .offset = 0 } 
+};
+
+
+// see pio_manager.h
+fn_status_t pio_manager_init(pio_manager_t *pio_spi, uint8_t copi, uint8_t cipo, uint8_t sck, uint8_t csn, uint32_t baudrate) {
+
+  PIO pio_blocks[2] = { pio0, pio1 };
+
+  fn_status_t status = ERROR;
+
+  // find a PIO block with an unused state machine and room for the program
+  for (size_t i = 0; (i < 2) && (status == ERROR); i++)
+  {
+    PIO pio = pio_blocks[i];
+
+    int sm = pio_claim_unused_sm(pio, false);
+
+    if (sm < 0) { continue; }
+
+    if (program_state[i].users == 0)
+    {
+      if (!pio_can_add_program(pio, &nrf24_spi_program))
+      {
+        pio_sm_unclaim(pio, sm);
+        continue;
+      }
+
+      program_state[i].offset = pio_add_program(pio, &nrf24_spi_program);
+    }
+
+    program_state[i].users++;
+
+    pio_spi->pio = pio;
+    pio_spi->sm = (uint)sm;
+    pio_spi->offset = program_state[i].offset;
+
+    status = SPI_MNGR_OK;
+  }
+
+  if (status == SPI_MNGR_OK)
+  {
+    PIO pio = pio_spi->pio;
+    uint sm = pio_spi->sm;
+
+    pio_sm_config config = nrf24_spi_program_get_default_config(pio_spi->offset);
+
+    sm_config_set_out_pins(&config, copi, 1);
+    sm_config_set_in_pins(&config, cipo);
+    sm_config_set_set_pins(&config, csn, 1);
+    sm_config_set_sideset_pins(&config, sck);
+
+    // shift MSB first, autopull and autopush every 8 bits
+    sm_config_set_out_shift(&config, false, true, 8);
+    sm_config_set_in_shift(&config, false, true, 8);
+
+    // a faster SCK samples CIPO before it is valid
+    if (baudrate > PIO_MAX_BAUDRATE) { baudrate = PIO_MAX_BAUDRATE; }
+
+    sm_config_set_clkdiv(&config, (float)clock_get_hz(clk_sys) / (float)(PIO_CYCLES_PER_BIT * baudrate));
+
+    // CSN HIGH, SCK & COPI LOW before the pins are handed to the PIO block
+    pio_sm_set_pins_with_mask(pio, sm, (1u << csn), (1u << csn) | (1u << sck) | (1u << copi));
+    pio_sm_set_pindirs_with_mask(pio, sm, (1u << csn) | (1u << sck) | (1u << copi), (1u << csn) | (1u << sck) | (1u << copi) | (1u << cipo));
+
+    pio_gpio_init(pio, copi);
+    pio_gpio_init(pio, cipo);
+    pio_gpio_init(pio, sck);
+    pio_gpio_init(pio, csn);
+
+    pio_sm_init(pio, sm, pio_spi->offset, &config);
+    pio_sm_set_enabled(pio, sm, true);
+  }
+
+  return status;
+}
+
+
+// see pio_manager.h
+void pio_manager_deinit(pio_manager_t *pio_spi) {
+
+  program_state_t *program = &(program_state[pio_get_index(pio_spi->pio)]);
+
+  pio_sm_set_enabled(pio_spi->pio, pio_spi->sm, false);
+  pio_sm_unclaim(pio_spi->pio, pio_spi->sm);
+
+  if (program->users > 0)
+  {
+    program->users--;
+
+    // remove the program with its last state machine
+    if (program->users == 0) { pio_remove_program(pio_spi->pio, &nrf24_spi_program, program->offset); }
+  }
+
+  return;
+}
+
+
+// see pio_manager.h
+fn_status_t pio_manager_transfer(pio_manager_t *pio_spi, const uint8_t *tx_buffer, uint8_t *rx_buffer, size_t len) {
+
+  spi_manager_frame_t frame = { .tx_buffer = tx_buffer, .rx_buffer = rx_buffer, .len = len };
+
+  return pio_manager_transfer_batch(pio_spi, &frame, 1);
+}
+
+
+// see pio_manager.h
+fn_status_t pio_manager_transfer_batch(pio_manager_t *pio_spi, const spi_manager_frame_t *frames, size_t count) {
+
+  PIO pio = pio_spi->pio;
+  uint sm = pio_spi->sm;
+
+  fn_status_t status = SPI_MNGR_OK;
+
+  // every frame must hold at least one byte
+  for (size_t i = 0; i < count; i++)
+  {
+    if (frames[i].len == 0) { status = ERROR; }
+  }
+
+  if (status == SPI_MNGR_OK)
+  {
+    // TX FIFO position: frame, byte in frame and frame header flag
+    size_t tx_frame = 0;
+    size_t tx_byte = 0;
+    bool is_tx_header = true;
+
+    // RX FIFO position: frame and byte in frame
+    size_t rx_frame = 0;
+    size_t rx_byte = 0;
+
+    // keep the TX FIFO topped up, whilst draining the RX FIFO
+    while (rx_frame < count)
+    {
+      if ((tx_frame < count) && !pio_sm_is_tx_fifo_full(pio, sm))
+      {
+        const spi_manager_frame_t *frame = &(frames[tx_frame]);
+
+        if (is_tx_header)
+        {
+          // frame header, number of bits in the frame - 1
+          pio_sm_put(pio, sm, (frame->len * 8) - 1);
+          is_tx_header = false;
+
+        } else {
+
+          uint8_t byte = (frame->tx_buffer != NULL) ? frame->tx_buffer[tx_byte] : PIO_NOP_BYTE;
+
+          // left-justified, as the OSR shifts MSB first
+          pio_sm_put(pio, sm, (uint32_t)byte << 24);
+
+          if (++tx_byte == frame->len)
+          {
+            tx_frame++;
+            tx_byte = 0;
+            is_tx_header = true;
+          }
+        }
+      }
+
+      if (!pio_sm_is_rx_fifo_empty(pio, sm))
+      {
+        const spi_manager_frame_t *frame = &(frames[rx_frame]);
+
+        uint8_t byte = (uint8_t)pio_sm_get(pio, sm);
+
+        if (frame->rx_buffer != NULL) { frame->rx_buffer[rx_byte] = byte; }
+
+        if (++rx_byte == frame->len)
+        {
+          rx_frame++;
+          rx_byte = 0;
+        }
+      }
+    }
+  }
+
+  return status;
+}
+
+
+// see pio_manager.h
+fn_status_t pio_manager_write_command(pio_manager_t *pio_spi, uint8_t command, const uint8_t *buffer, size_t len, uint8_t *status_reg) {
+
+  PIO pio = pio_spi->pio;
+  uint sm = pio_spi->sm;
+
+  // a state machine released by pio_manager_deinit would never clock the frame
+  bool is_claimed = (pio != NULL) && pio_sm_is_claimed(pio, sm);
+
+  fn_status_t status = (((buffer != NULL) || (len == 0)) && is_claimed) ? SPI_MNGR_OK : ERROR;
+
+  if (status == SPI_MNGR_OK)
+  {
+    // command byte + buffer
+    size_t total_len = len + 1;
+
+    // frame header, number of bits in the frame - 1
+    pio_sm_put_blocking(pio, sm, (total_len * 8) - 1);
+
+    size_t tx_byte = 0;
+    size_t rx_byte = 0;
+
+    // keep the TX FIFO topped up, whilst draining the RX FIFO
+    while (rx_byte < total_len)
+    {
+      if ((tx_byte < total_len) && !pio_sm_is_tx_fifo_full(pio, sm))
+      {
+        uint8_t byte = (tx_byte == 0) ? command : buffer[tx_byte - 1];
+
+        // left-justified, as the OSR shifts MSB first
+        pio_sm_put(pio, sm, (uint32_t)byte << 24);
+        tx_byte++;
+      }
+
+      if (!pio_sm_is_rx_fifo_empty(pio, sm))
+      {
+        uint8_t byte = (uint8_t)pio_sm_get(pio, sm);
+
+        // STATUS register is clocked in with the command byte
+        if ((rx_byte == 0) && (status_reg != NULL)) { *status_reg = byte; }
+
+        rx_byte++;
+      }
+    }
+  }
+
+  return status;
+}
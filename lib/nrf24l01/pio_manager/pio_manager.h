@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) 2021, A. Ridyard.
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License v2.0 as
+ * published by the Free Software Foundation.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * @file pio_manager.h
+ * 
+ * @brief type definitions and function declarations for communicating
+ * with the NRF24L01 over SPI, through a PIO state machine, which drives
+ * CSN itself and can use any GPIO pins.
+ */
+
+#ifndef PIO_MANAGER_H
+#define PIO_MANAGER_H
+
+#include "error_manager.h"
+#include "spi_manager.h"
+#include "hardware/pio.h"
+
+// highest SCK, at which CIPO is sampled after it is valid (see nrf24_spi.pio)
+#define PIO_MAX_BAUDRATE 7500000
+
+// PIO state machine information for pio_manager utility functions
+typedef struct pio_manager_s
+{
+  PIO pio; // PIO block (pio0 or pio1)
+  uint sm; // state machine in the PIO block
+  uint offset; // nrf24_spi program offset in PIO instruction memory
+} pio_manager_t;
+
+
+/**
+ * Claims an unused state machine on either PIO block, loads the 
+ * nrf24_spi program (if not already loaded on that PIO block) and 
+ * initialises the state machine and GPIO pins. CSN is left HIGH.
+ * The baudrate is limited to PIO_MAX_BAUDRATE.
+ * 
+ * @param pio_spi pio_manager_t struct, set on success
+ * @param copi COPI pin number
+ * @param cipo CIPO pin number
+ * @param sck SCK pin number
+ * @param csn CSN pin number
+ * @param baudrate baudrate in Hz
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+fn_status_t pio_manager_init(pio_manager_t *pio_spi, uint8_t copi, uint8_t cipo, uint8_t sck, uint8_t csn, uint32_t baudrate);
+
+
+/**
+ * Disables and unclaims the state machine. The nrf24_spi program is 
+ * removed from the PIO block, once its last state machine is unclaimed.
+ * 
+ * @param pio_spi pio_manager_t struct
+ */
+void pio_manager_deinit(pio_manager_t *pio_spi);
+
+
+/**
+ * Performs a simultaneous read/write to the NRF24L01, as one CSN 
+ * framed transfer clocked by the state machine. NOP bytes are 
+ * clocked out if tx_buffer is NULL and bytes clocked in are 
+ * discarded if rx_buffer is NULL.
+ * 
+ * @param pio_spi pio_manager_t struct
+ * @param tx_buffer write buffer or NULL
+ * @param rx_buffer read buffer or NULL
+ * @param len bytes in buffers
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+fn_status_t pio_manager_transfer(pio_manager_t *pio_spi, const uint8_t *tx_buffer, uint8_t *rx_buffer, size_t len);
+
+
+/**
+ * Performs a batch of CSN framed transfers to the NRF24L01. Every 
+ * frame is queued in the state machine TX FIFO as it drains, so 
+ * frames are clocked back to back, with only the CSN HIGH time 
+ * between them. The responses to every frame are available once 
+ * the function returns.
+ * 
+ * @param pio_spi pio_manager_t struct
+ * @param frames array of frames
+ * @param count number of frames
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+fn_status_t pio_manager_transfer_batch(pio_manager_t *pio_spi, const spi_manager_frame_t *frames, size_t count);
+
+/**
+ * Writes a command byte, followed by len bytes streamed directly 
+ * from buffer, to the NRF24L01 as one CSN framed transfer clocked 
+ * by the state machine. Only the STATUS register, clocked in with 
+ * the command byte, is read and the remaining bytes are discarded.
+ * 
+ * @note ERROR (0) is returned without a transfer, if buffer is NULL 
+ * and len is not 0, or if the state machine is not claimed.
+ * 
+ * @param pio_spi pio_manager_t struct
+ * @param command command byte (W_REGISTER, W_TX_PAYLOAD etc.)
+ * @param buffer write buffer (may be NULL if len is 0)
+ * @param len bytes in buffer
+ * @param status_reg STATUS register value or NULL
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+fn_status_t pio_manager_write_command(pio_manager_t *pio_spi, uint8_t command, const uint8_t *buffer, size_t len, uint8_t *status_reg);
+
+#endif // PIO_MANAGER_H
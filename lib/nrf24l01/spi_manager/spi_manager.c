@@ -16,6 +16,209 @@
  * over SPI.
  */
 #include "spi_manager.h"
+#include "pin_manager.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+
+// SPI session state for an SPI instance
+typedef struct spi_session_s
+{
+  // number of open sessions on the SPI instance
+  uint8_t sessions;
+
+  // baudrate the SPI instance was initialised with
+  uint32_t baudrate;
+
+  // CSN LOW to first SCK edge and last SCK edge to CSN HIGH delays, in sys_clk cycles
+  uint32_t csn_setup_cycles;
+  uint32_t csn_hold_cycles;
+
+  // DMA channels paced by SPI TX and RX DREQ (-1 if unclaimed)
+  int dma_tx;
+  int dma_rx;
+
+  // DMA transfer in progress flag
+  volatile bool is_busy;
+
+  // holds on the SPI bus, by any driver instance sharing it (see spi_manager_hold)
+  volatile uint8_t holds;
+
+  // CSN pin of the DMA transfer in progress
+  uint8_t csn;
+
+  // DMA transfer completion callback and its user data
+  spi_manager_callback_t callback;
+  void *user_data;
+} spi_session_t;
+
+// SPI session state, indexed by SPI instance (SPI_0, SPI_1)
+static spi_session_t spi_session[2] = { 
+  { .sessions = 0, .baudrate = 0, .csn_setup_cycles = 0, .csn_hold_cycles = 0, .dma_tx = -1, .dma_rx = -1, .is_busy = false, .holds = 0 }, 
+  { .sessions = 0, .baudrate = 0, .csn_setup_cycles = 0, .csn_hold_cycles = 0, .dma_tx = -1, .dma_rx = -1, .is_busy = false, .holds = 0 } 
+};
+
+// clocked out by the TX channel when there is no tx_buffer
+static const uint8_t dma_nop = 0xFF;
+
+// written to by the RX channel when there is no rx_buffer
+static uint8_t dma_discard;
+
+
+/**
+ * DMA_IRQ_0 handler. The RX channel of an asynchronous DMA transfer 
+ * completes once the last byte has been clocked in, at which point 
+ * CSN is driven HIGH and the completion callback is called. The
+ * interrupt is only enabled for asynchronous transfers, so blocking
+ * transfers do not depend on this handler being able to run.
+ */
+static void spi_manager_dma_handler(void) {
+
+  for (size_t i = 0; i < 2; i++)
+  {
+    spi_session_t *session = &(spi_session[i]);
+
+    if ((session->dma_rx >= 0) && dma_channel_get_irq0_status(session->dma_rx))
+    {
+      dma_channel_acknowledge_irq0(session->dma_rx);
+      dma_channel_set_irq0_enabled(session->dma_rx, false);
+
+      if (session->csn_hold_cycles) { busy_wait_at_least_cycles(session->csn_hold_cycles); }
+
+      csn_put_high(session->csn); // drive CSN pin HIGH
+
+      session->is_busy = false;
+
+      if (session->callback != NULL) { session->callback(SPI_MNGR_OK, session->user_data); }
+    }
+  }
+
+  return;
+}
+
+
+/**
+ * Configures the TX and RX DMA channels of the SPI session for
+ * a transfer of len bytes, without starting them. NOP bytes are
+ * clocked out if tx_buffer is NULL and bytes clocked in are 
+ * discarded if rx_buffer is NULL.
+ * 
+ * @param session SPI session state
+ * @param instance SPI instance pointer
+ * @param tx_buffer write buffer or NULL
+ * @param rx_buffer read buffer or NULL
+ * @param len bytes in buffers
+ */
+static void spi_manager_dma_configure(spi_session_t *session, spi_inst_t *instance, const uint8_t *tx_buffer, uint8_t *rx_buffer, size_t len) {
+
+  volatile void *spi_dr = &(spi_get_hw(instance)->dr);
+
+  // TX channel reads tx_buffer (or NOP byte) into SPI data register, paced by SPI TX DREQ
+  dma_channel_config tx_config = dma_channel_get_default_config(session->dma_tx);
+  channel_config_set_transfer_data_size(&tx_config, DMA_SIZE_8);
+  channel_config_set_dreq(&tx_config, spi_get_dreq(instance, true));
+  channel_config_set_read_increment(&tx_config, tx_buffer != NULL);
+  channel_config_set_write_increment(&tx_config, false);
+
+  dma_channel_configure(session->dma_tx, &tx_config, spi_dr, (tx_buffer != NULL) ? tx_buffer : &dma_nop, len, false);
+
+  // RX channel writes SPI data register into rx_buffer (or discard byte), paced by SPI RX DREQ
+  dma_channel_config rx_config = dma_channel_get_default_config(session->dma_rx);
+  channel_config_set_transfer_data_size(&rx_config, DMA_SIZE_8);
+  channel_config_set_dreq(&rx_config, spi_get_dreq(instance, false));
+  channel_config_set_read_increment(&rx_config, false);
+  channel_config_set_write_increment(&rx_config, rx_buffer != NULL);
+
+  dma_channel_configure(session->dma_rx, &rx_config, (rx_buffer != NULL) ? rx_buffer : &dma_discard, spi_dr, len, false);
+
+  return;
+}
+
+
+/**
+ * Waits for a blocking DMA transfer, started with the DMA_IRQ_0 
+ * interrupt disabled, by polling the RX channel, which completes 
+ * once the last byte has been clocked in. Safe to call from an 
+ * interrupt handler, at any priority.
+ * 
+ * @param session SPI session state
+ */
+static void spi_manager_dma_wait(spi_session_t *session) {
+
+  while (dma_channel_is_busy(session->dma_rx)) { tight_loop_contents(); }
+
+  // the raw interrupt flag is cleared, so it is not taken when the interrupt is next enabled
+  dma_channel_acknowledge_irq0(session->dma_rx);
+
+  return;
+}
+
+
+/**
+ * Claims a pair of DMA channels for the SPI instance. The 
+ * DMA_IRQ_0 handler is shared with other users of DMA_IRQ_0
+ * and is added when the first pair of channels is claimed.
+ * 
+ * @note DMA transfers fall back to spi_manager_transfer, if
+ * there are no unused DMA channels.
+ * 
+ * @param session SPI session state
+ */
+static void spi_manager_dma_claim(spi_session_t *session) {
+
+  // claim TX and RX channels, without panic if unavailable
+  session->dma_tx = dma_claim_unused_channel(false);
+  session->dma_rx = dma_claim_unused_channel(false);
+
+  if ((session->dma_tx < 0) || (session->dma_rx < 0))
+  {
+    if (session->dma_tx >= 0) { dma_channel_unclaim(session->dma_tx); }
+    if (session->dma_rx >= 0) { dma_channel_unclaim(session->dma_rx); }
+
+    session->dma_tx = -1;
+    session->dma_rx = -1;
+
+  } else {
+
+    // add DMA_IRQ_0 handler, if not added by the other SPI instance
+    if ((spi_session[SPI_0].dma_rx < 0) || (spi_session[SPI_1].dma_rx < 0))
+    {
+      irq_add_shared_handler(DMA_IRQ_0, spi_manager_dma_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+      irq_set_enabled(DMA_IRQ_0, true);
+    }
+  }
+
+  return;
+}
+
+
+/**
+ * Unclaims the DMA channels of the SPI instance and removes
+ * the DMA_IRQ_0 handler, if no other channels are claimed.
+ * 
+ * @param session SPI session state
+ */
+static void spi_manager_dma_unclaim(spi_session_t *session) {
+
+  if (session->dma_rx >= 0)
+  {
+    dma_channel_set_irq0_enabled(session->dma_rx, false);
+
+    dma_channel_unclaim(session->dma_tx);
+    dma_channel_unclaim(session->dma_rx);
+
+    session->dma_tx = -1;
+    session->dma_rx = -1;
+
+    // remove DMA_IRQ_0 handler, if not used by the other SPI instance
+    if ((spi_session[SPI_0].dma_rx < 0) && (spi_session[SPI_1].dma_rx < 0))
+    {
+      irq_remove_handler(DMA_IRQ_0, spi_manager_dma_handler);
+    }
+  }
+
+  return;
+}
 
 
 // see spi_manager.h
@@ -44,12 +247,79 @@ void spi_manager_deinit_spi(spi_inst_t *instance) {
 } 
 
 
+// see spi_manager.h
+fn_status_t spi_manager_open(spi_inst_t *instance, uint32_t baudrate) {
+
+  spi_session_t *session = &(spi_session[spi_get_index(instance)]);
+
+  // SPI instance is initialised once, by the first session
+  if (session->sessions == 0)
+  {
+    spi_manager_init_spi(instance, baudrate);
+
+    spi_manager_dma_claim(session);
+
+    session->baudrate = baudrate;
+  }
+
+  session->sessions++;
+
+  return SPI_MNGR_OK;
+}
+
+
+// see spi_manager.h
+void spi_manager_close(spi_inst_t *instance) {
+
+  spi_session_t *session = &(spi_session[spi_get_index(instance)]);
+
+  if (session->sessions > 0)
+  {
+    session->sessions--;
+
+    // SPI instance is deinitialised when the last session closes
+    if (session->sessions == 0) 
+    { 
+      // wait for a DMA transfer in progress
+      while (session->is_busy) { tight_loop_contents(); }
+
+      spi_manager_dma_unclaim(session);
+
+      spi_manager_deinit_spi(instance); 
+    }
+  }
+
+  return;
+}
+
+
+// see spi_manager.h
+void spi_manager_csn_timing(spi_inst_t *instance, uint32_t setup_ns, uint32_t hold_ns) {
+
+  spi_session_t *session = &(spi_session[spi_get_index(instance)]);
+
+  // sys_clk cycles per μS, rounding nanoseconds up to whole cycles
+  uint32_t cycles_per_us = clock_get_hz(clk_sys) / 1000000;
+
+  session->csn_setup_cycles = ((setup_ns * cycles_per_us) + 999) / 1000;
+  session->csn_hold_cycles = ((hold_ns * cycles_per_us) + 999) / 1000;
+
+  return;
+}
+
+
 // see spi_manager.h
 fn_status_t spi_manager_transfer(spi_inst_t *instance, const uint8_t *tx_buffer, uint8_t *rx_buffer, size_t len) {
 
-  sleep_us(2);
+  spi_session_t *session = &(spi_session[spi_get_index(instance)]);
+
+  // CSN setup time, if configured (CSN is driven LOW by the caller)
+  if (session->csn_setup_cycles) { busy_wait_at_least_cycles(session->csn_setup_cycles); }
+
   uint8_t bytes = spi_write_read_blocking(instance, tx_buffer, rx_buffer, len);
-  sleep_us(2);
+
+  // CSN hold time, if configured (CSN is driven HIGH by the caller)
+  if (session->csn_hold_cycles) { busy_wait_at_least_cycles(session->csn_hold_cycles); }
 
   // check that bytes written/read match bytes in tx_buffer & rx_buffer
   fn_status_t status = (bytes == len) ? SPI_MNGR_OK : ERROR;
@@ -58,5 +328,226 @@ fn_status_t spi_manager_transfer(spi_inst_t *instance, const uint8_t *tx_buffer,
 }
 
 
+// see spi_manager.h
+fn_status_t spi_manager_transfer_batch(spi_inst_t *instance, uint8_t csn, const spi_manager_frame_t *frames, size_t count) {
+
+  spi_session_t *session = &(spi_session[spi_get_index(instance)]);
+
+  fn_status_t status = SPI_MNGR_OK;
+
+  for (size_t i = 0; (i < count) && (status == SPI_MNGR_OK); i++)
+  {
+    const spi_manager_frame_t *frame = &(frames[i]);
+
+    // payload frames are clocked by DMA, CSN driven LOW and HIGH by spi_manager
+    if ((session->dma_rx >= 0) && (frame->len >= DMA_MIN_BYTES))
+    {
+      status = spi_manager_transfer_dma(instance, csn, frame->tx_buffer, frame->rx_buffer, frame->len);
+      continue;
+    }
+
+    int bytes = 0;
+
+    csn_put_low(csn); // drive CSN pin LOW
+
+    if (session->csn_setup_cycles) { busy_wait_at_least_cycles(session->csn_setup_cycles); }
+
+    if ((frame->tx_buffer == NULL) && (frame->rx_buffer == NULL))
+    {
+      // invalid frame, bytes remains 0
+    }
+    else if (frame->rx_buffer == NULL)
+    {
+      // write only frame, bytes clocked in are discarded
+      bytes = spi_write_blocking(instance, frame->tx_buffer, frame->len);
+    }
+    else if (frame->tx_buffer == NULL)
+    {
+      // read only frame, NOP bytes clocked out
+      bytes = spi_read_blocking(instance, NOP_BYTE, frame->rx_buffer, frame->len);
+
+    } else {
+
+      bytes = spi_write_read_blocking(instance, frame->tx_buffer, frame->rx_buffer, frame->len);
+    }
+
+    if (session->csn_hold_cycles) { busy_wait_at_least_cycles(session->csn_hold_cycles); }
+
+    csn_put_high(csn); // drive CSN pin HIGH
+
+    status = (bytes == (int)frame->len) ? SPI_MNGR_OK : ERROR;
+  }
+
+  return status;
+}
+
+
+// see spi_manager.h
+fn_status_t spi_manager_write_command(spi_inst_t *instance, uint8_t csn, uint8_t command, const uint8_t *buffer, size_t len, uint8_t *status_reg) {
+
+  spi_session_t *session = &(spi_session[spi_get_index(instance)]);
+
+  // only one DMA transfer at a time on an SPI instance
+  fn_status_t status = (session->is_busy) ? ERROR : SPI_MNGR_OK;
+
+  if (status == SPI_MNGR_OK)
+  {
+    uint8_t status_byte = 0;
+
+    csn_put_low(csn); // drive CSN pin LOW
+
+    if (session->csn_setup_cycles) { busy_wait_at_least_cycles(session->csn_setup_cycles); }
+
+    // STATUS register is clocked in with the command byte
+    int bytes = spi_write_read_blocking(instance, &command, &status_byte, 1);
+
+    if ((session->dma_rx >= 0) && (len >= DMA_MIN_BYTES))
+    {
+      // buffer is streamed by DMA, bytes clocked in are discarded
+      spi_manager_dma_configure(session, instance, buffer, NULL, len);
+      dma_start_channel_mask((1u << session->dma_tx) | (1u << session->dma_rx));
+
+      spi_manager_dma_wait(session);
+
+      bytes += (int)len;
+
+    } else if (len) {
+
+      bytes += spi_write_blocking(instance, buffer, len);
+    }
+
+    if (session->csn_hold_cycles) { busy_wait_at_least_cycles(session->csn_hold_cycles); }
+
+    csn_put_high(csn); // drive CSN pin HIGH
+
+    if (status_reg != NULL) { *status_reg = status_byte; }
+
+    status = (bytes == (int)(len + 1)) ? SPI_MNGR_OK : ERROR;
+  }
+
+  return status;
+}
+
+
+// see spi_manager.h
+fn_status_t spi_manager_transfer_dma_async(spi_inst_t *instance, uint8_t csn, const uint8_t *tx_buffer, uint8_t *rx_buffer, size_t len, spi_manager_callback_t callback, void *user_data) {
+
+  spi_session_t *session = &(spi_session[spi_get_index(instance)]);
+
+  // only one DMA transfer at a time on an SPI instance
+  fn_status_t status = (session->is_busy || (len == 0)) ? ERROR : SPI_MNGR_OK;
+
+  if ((status == SPI_MNGR_OK) && (session->dma_rx < 0))
+  {
+    /**
+     * no DMA channels were available for the SPI instance, so 
+     * the transfer is made with spi_manager_transfer instead.
+     * Without a tx_buffer or rx_buffer, the transfer is made one
+     * byte at a time, clocking out NOP bytes or discarding bytes 
+     * clocked in, so no buffer of len bytes is needed.
+     */
+    uint8_t tx_nop = NOP_BYTE;
+    uint8_t rx_discard = 0;
+
+    csn_put_low(csn); // drive CSN pin LOW
+
+    if ((tx_buffer != NULL) && (rx_buffer != NULL)) { status = spi_manager_transfer(instance, tx_buffer, rx_buffer, len); }
+
+    for (size_t i = 0; ((tx_buffer == NULL) || (rx_buffer == NULL)) && (i < len) && (status == SPI_MNGR_OK); i++)
+    {
+      status = spi_manager_transfer(instance, (tx_buffer != NULL) ? &tx_buffer[i] : &tx_nop, (rx_buffer != NULL) ? &rx_buffer[i] : &rx_discard, 1);
+    }
+
+    csn_put_high(csn); // drive CSN pin HIGH
+
+    if (callback != NULL) { callback(status, user_data); }
+  }
+  else if (status == SPI_MNGR_OK)
+  {
+    session->is_busy = true;
+    session->csn = csn;
+    session->callback = callback;
+    session->user_data = user_data;
+
+    spi_manager_dma_configure(session, instance, tx_buffer, rx_buffer, len);
+
+    // disabled again by spi_manager_dma_handler, once the transfer completes
+    dma_channel_set_irq0_enabled(session->dma_rx, true);
+
+    csn_put_low(csn); // drive CSN pin LOW
+
+    if (session->csn_setup_cycles) { busy_wait_at_least_cycles(session->csn_setup_cycles); }
+
+    // start both channels together, CSN is driven HIGH by spi_manager_dma_handler
+    dma_start_channel_mask((1u << session->dma_tx) | (1u << session->dma_rx));
+  }
+
+  return status;
+}
+
+
+// see spi_manager.h
+fn_status_t spi_manager_transfer_dma(spi_inst_t *instance, uint8_t csn, const uint8_t *tx_buffer, uint8_t *rx_buffer, size_t len) {
+
+  spi_session_t *session = &(spi_session[spi_get_index(instance)]);
+
+  // only one DMA transfer at a time on an SPI instance
+  fn_status_t status = (session->is_busy || (len == 0)) ? ERROR : SPI_MNGR_OK;
+
+  if ((status == SPI_MNGR_OK) && (session->dma_rx < 0))
+  {
+    // no DMA channels, so the asynchronous fallback completes the transfer before returning
+    status = spi_manager_transfer_dma_async(instance, csn, tx_buffer, rx_buffer, len, NULL, NULL);
+  }
+  else if (status == SPI_MNGR_OK)
+  {
+    spi_manager_dma_configure(session, instance, tx_buffer, rx_buffer, len);
+
+    csn_put_low(csn); // drive CSN pin LOW
+
+    if (session->csn_setup_cycles) { busy_wait_at_least_cycles(session->csn_setup_cycles); }
+
+    dma_start_channel_mask((1u << session->dma_tx) | (1u << session->dma_rx));
+
+    // polled, as the DMA_IRQ_0 handler may not preempt an interrupt handler calling this function
+    spi_manager_dma_wait(session);
+
+    if (session->csn_hold_cycles) { busy_wait_at_least_cycles(session->csn_hold_cycles); }
+
+    csn_put_high(csn); // drive CSN pin HIGH
+  }
+
+  return status;
+}
+
+
+// see spi_manager.h
+bool spi_manager_is_busy(spi_inst_t *instance) {
 
+  return spi_session[spi_get_index(instance)].is_busy;
+}
 
+
+// see spi_manager.h
+void spi_manager_hold(spi_inst_t *instance) {
+
+  spi_session[spi_get_index(instance)].holds++;
+
+  return;
+}
+
+
+// see spi_manager.h
+void spi_manager_release(spi_inst_t *instance) {
+
+  spi_session[spi_get_index(instance)].holds--;
+
+  return;
+}
+
+
+// see spi_manager.h
+bool spi_manager_is_held(spi_inst_t *instance) {
+
+  return spi_session[spi_get_index(instance)].holds != 0;
+}
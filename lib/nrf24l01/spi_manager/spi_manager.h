@@ -23,9 +23,26 @@
 #include "hardware/spi.h"
 #include <pico/time.h>
 
+// NRF24L01 NOP command, clocked out when there is no tx_buffer
+#define NOP_BYTE 0xFF
+
+// frames of this many bytes or more in a batch are clocked by DMA
+#define DMA_MIN_BYTES 8
+
 // corresponding SPI instance (SPI_0, SPI_1) when checking GPIO pins
 typedef enum spi_instance_e { SPI_0, SPI_1 } spi_instance_t;
 
+// DMA transfer completion callback, called from the DMA_IRQ_0 handler
+typedef void (*spi_manager_callback_t)(fn_status_t status, void *user_data);
+
+// a CSN framed command (command byte + data) in a batch of transfers
+typedef struct spi_manager_frame_s
+{
+  const uint8_t *tx_buffer; // write buffer or NULL (NOP bytes)
+  uint8_t *rx_buffer; // read buffer or NULL (discarded)
+  size_t len; // bytes in buffers
+} spi_manager_frame_t;
+
 
 /**
  * Initialise the SPI interface for read/write operations
@@ -41,6 +58,44 @@ void spi_manager_init_spi(spi_inst_t *instance, uint32_t baudrate);
 void spi_manager_deinit_spi(spi_inst_t *instance);
 
 
+/**
+ * Open an SPI session on the SPI instance. The SPI interface is 
+ * initialised by the first session opened on an instance and any 
+ * subsequent session on the same instance (a second NRF24L01 on a 
+ * shared bus) reuses it, at the baudrate it was first opened with.
+ * 
+ * @param instance SPI instance pointer
+ * @param baudrate baudrate in Hz
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+fn_status_t spi_manager_open(spi_inst_t *instance, uint32_t baudrate);
+
+
+/**
+ * Close an SPI session on the SPI instance. The SPI interface is 
+ * deinitialised once the last open session on it is closed.
+ * 
+ * @param instance SPI instance pointer
+ */
+void spi_manager_close(spi_inst_t *instance);
+
+
+/**
+ * Sets the CSN setup time (CSN LOW to first SCK edge) and hold 
+ * time (last SCK edge to CSN HIGH) applied around each transfer 
+ * on the SPI instance. The nRF24L01+ datasheet specifies a Tcc 
+ * and Tcch of 2nS, which is met by the time taken to drive CSN 
+ * and start the SPI peripheral, so no delay is applied by default. 
+ * Longer times may be useful with long wires or level shifters.
+ * 
+ * @param instance SPI instance pointer
+ * @param setup_ns CSN setup time in nS (0 for none)
+ * @param hold_ns CSN hold time in nS (0 for none)
+ */
+void spi_manager_csn_timing(spi_inst_t *instance, uint32_t setup_ns, uint32_t hold_ns);
+
+
 /**
  * Performs a simultaneous red/write to the NRF24L01 over
  * SPI.
@@ -54,4 +109,128 @@ void spi_manager_deinit_spi(spi_inst_t *instance);
  */
 fn_status_t spi_manager_transfer(spi_inst_t *instance, const uint8_t *tx_buffer, uint8_t *rx_buffer, size_t len);
 
+
+/**
+ * Performs a batch of CSN framed transfers to the NRF24L01 over 
+ * SPI, back to back, toggling CSN HIGH between each frame. The 
+ * responses to every frame are available once the function returns.
+ * A frame must have a tx_buffer, an rx_buffer, or both. Frames of
+ * DMA_MIN_BYTES or more (payloads) are clocked by DMA, if available.
+ * 
+ * @param instance SPI instance pointer
+ * @param csn CSN pin number
+ * @param frames array of frames
+ * @param count number of frames
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+fn_status_t spi_manager_transfer_batch(spi_inst_t *instance, uint8_t csn, const spi_manager_frame_t *frames, size_t count);
+
+
+/**
+ * Writes a command byte, followed by len bytes streamed directly
+ * from buffer, to the NRF24L01 over SPI in one CSN frame. Only the
+ * STATUS register, clocked in with the command byte, is read and 
+ * the remaining bytes clocked in are discarded, so no copy of the 
+ * buffer or read buffer is needed. A buffer of DMA_MIN_BYTES or 
+ * more (payloads) is clocked by DMA, if available.
+ * 
+ * @param instance SPI instance pointer
+ * @param csn CSN pin number
+ * @param command command byte (W_REGISTER, W_TX_PAYLOAD etc.)
+ * @param buffer write buffer (may be NULL if len is 0)
+ * @param len bytes in buffer
+ * @param status_reg STATUS register value or NULL
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+fn_status_t spi_manager_write_command(spi_inst_t *instance, uint8_t csn, uint8_t command, const uint8_t *buffer, size_t len, uint8_t *status_reg);
+
+
+/**
+ * Starts a simultaneous read/write to the NRF24L01 over SPI, 
+ * using a pair of DMA channels, and returns immediately. CSN
+ * is driven LOW before the transfer starts and driven HIGH
+ * when the last byte is clocked in, followed by a call to 
+ * callback (if not NULL) from the DMA_IRQ_0 handler.
+ * 
+ * NOP bytes are clocked out if tx_buffer is NULL and bytes 
+ * clocked in are discarded if rx_buffer is NULL. Both buffers
+ * must remain valid until the transfer completes.
+ * 
+ * @note The transfer is made through spi_manager_transfer, 
+ * if no DMA channels were available when the SPI session 
+ * was opened. ERROR (0) is returned if len is 0.
+ * 
+ * @param instance SPI instance pointer
+ * @param csn CSN pin number
+ * @param tx_buffer write buffer or NULL
+ * @param rx_buffer read buffer or NULL
+ * @param len bytes in buffers
+ * @param callback completion callback or NULL
+ * @param user_data passed to callback
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+fn_status_t spi_manager_transfer_dma_async(spi_inst_t *instance, uint8_t csn, const uint8_t *tx_buffer, uint8_t *rx_buffer, size_t len, spi_manager_callback_t callback, void *user_data);
+
+
+/**
+ * Performs a simultaneous read/write to the NRF24L01 over
+ * SPI, using a pair of DMA channels, and waits for the 
+ * transfer to complete, by polling the DMA channel, so it
+ * may be called from an interrupt handler. CSN is driven
+ * LOW and HIGH. See spi_manager_transfer_dma_async.
+ * 
+ * @param instance SPI instance pointer
+ * @param csn CSN pin number
+ * @param tx_buffer write buffer or NULL
+ * @param rx_buffer read buffer or NULL
+ * @param len bytes in buffers
+ * 
+ * @return SPI_MNGR_OK (2), ERROR (0)
+ */
+fn_status_t spi_manager_transfer_dma(spi_inst_t *instance, uint8_t csn, const uint8_t *tx_buffer, uint8_t *rx_buffer, size_t len);
+
+
+/**
+ * Indicates if a DMA transfer is in progress on the SPI 
+ * instance.
+ * 
+ * @param instance SPI instance pointer
+ * 
+ * @return true if a DMA transfer is in progress
+ */
+bool spi_manager_is_busy(spi_inst_t *instance);
+
+
+/**
+ * Holds the SPI bus for the duration of a transfer or sequence 
+ * of transfers. Holds nest and are counted per SPI instance, so
+ * an interrupt handler serving any NRF24L01 on a shared bus can 
+ * check spi_manager_is_held, before starting a transfer which 
+ * would otherwise interleave with the one it preempted.
+ * 
+ * @param instance SPI instance pointer
+ */
+void spi_manager_hold(spi_inst_t *instance);
+
+
+/**
+ * Releases a hold on the SPI bus, taken by spi_manager_hold.
+ * 
+ * @param instance SPI instance pointer
+ */
+void spi_manager_release(spi_inst_t *instance);
+
+
+/**
+ * Indicates if the SPI bus is held by any driver instance.
+ * 
+ * @param instance SPI instance pointer
+ * 
+ * @return true if the SPI bus is held
+ */
+bool spi_manager_is_held(spi_inst_t *instance);
+
 #endif // SPI_MANAGER_H
\ No newline at end of file